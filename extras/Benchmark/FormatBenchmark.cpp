@@ -0,0 +1,143 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+/**
+ * Compares the library formatter with vsnprintf on the same format strings and values.
+ *
+ *     g++ -std=c++11 -O2 -I../../src FormatBenchmark.cpp ../../src/SPIN/Log/Format/TypedFormat.cpp \
+ *         ../../src/SPIN/Log/Format/NumberFormat.cpp -o spin-format-benchmark
+ *     spin-format-benchmark [iterations]
+ *
+ * Every configuration is checked for identical output before it is timed. "list" is the
+ * va_list front end CFormattedLogger uses, "typed" is the LogTyped path.
+ **/
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <SPIN/Log/Format/NumberFormat.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
+
+static volatile std::size_t sink = 0;
+
+
+static std::size_t ViaVsnprintf(char* out, std::size_t capacity, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(out, capacity, fmt, args);
+    va_end(args);
+
+    return (written < 0) ? 0 : (std::size_t)written;
+}
+static std::size_t ViaList(char* out, std::size_t capacity, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    std::size_t written = SPIN::Log::Format::FormatArgumentList(out, capacity, fmt, args);
+    va_end(args);
+
+    return written;
+}
+template<typename... Args>
+static std::size_t ViaTyped(char* out, std::size_t capacity, const char* fmt, const Args&... args)
+{
+    SPIN::Log::Format::Argument arguments[] = { SPIN::Log::Format::MakeArgument(args)... };
+
+    return SPIN::Log::Format::FormatArguments(out, capacity, fmt, arguments, sizeof...(Args));
+}
+
+template<typename Function>
+static double Time(long iterations, Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++)
+    {
+        sink += function(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)iterations;
+}
+
+template<typename... Args>
+static bool Run(long iterations, const char* name, const char* fmt, Args... args)
+{
+    char expected[256];
+    char actual[256];
+    char typed[256];
+    ViaVsnprintf(expected, sizeof(expected), fmt, args...);
+    ViaList(actual, sizeof(actual), fmt, args...);
+    ViaTyped(typed, sizeof(typed), fmt, args...);
+    if (strcmp(expected, actual) != 0 || strcmp(expected, typed) != 0)
+    {
+        printf("%-14s MISMATCH \"%s\" \"%s\" \"%s\"\n", name, expected, actual, typed);
+        return false;
+    }
+
+    char buffer[256];
+    double reference = Time(iterations, [&](long) { return ViaVsnprintf(buffer, sizeof(buffer), fmt, args...); });
+    double list = Time(iterations, [&](long) { return ViaList(buffer, sizeof(buffer), fmt, args...); });
+    double typedTime = Time(iterations, [&](long) { return ViaTyped(buffer, sizeof(buffer), fmt, args...); });
+
+    printf("%-14s %10.1f %10.1f %10.1f %8.2fx   %s\n", name, reference, list, typedTime, reference / list, expected);
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    long iterations = (argc > 1) ? atol(argv[1]) : 1000000;
+    bool matched = true;
+
+    printf("%-14s %10s %10s %10s %9s\n", "ns/line", "vsnprintf", "list", "typed", "speedup");
+    matched &= Run(iterations, "int", "count=%d", 1234567);
+    matched &= Run(iterations, "int64", "ticks=%lld", 9876543210123LL);
+    matched &= Run(iterations, "hex", "reg=0x%08x", 0xBEEFu);
+    matched &= Run(iterations, "fixed %.2f", "temp=%.2f", 23.456);
+    matched &= Run(iterations, "fixed %f", "alt=%f", 1234.56789);
+    matched &= Run(iterations, "fixed %.6f", "lat=%.6f", -33.868820);
+    matched &= Run(iterations, "general %g", "v=%g", 0.0125);
+    matched &= Run(iterations, "exponent %e", "p=%e", 101325.0);
+    matched &= Run(iterations, "sensor line", "T=%.2f H=%.1f P=%.1f V=%.3f n=%u", 21.37, 45.2, 1013.25, 3.301, 42u);
+    matched &= Run(iterations, "mixed line", "%s #%d %5.1f%% 0x%04X", "battery", 3, 87.5, 0x1Fu);
+
+    // Shortest round trip text against the "%.17g" it replaces.
+    const double samples[] = { 0.1, 23.456, 1013.25, -33.86882, 6.02214076e23, 1e-7 };
+    char buffer[64];
+    double reference = Time(iterations, [&](long i) { return (std::size_t)snprintf(buffer, sizeof(buffer), "%.17g", samples[i % 6]); });
+    double shortest = Time(iterations, [&](long i) { return SPIN::Log::Format::FormatShortest(buffer, samples[i % 6]); });
+    for (std::size_t i = 0; i < 6; i++)
+    {
+        buffer[SPIN::Log::Format::FormatShortest(buffer, samples[i])] = '\0';
+        matched &= strtod(buffer, nullptr) == samples[i];
+    }
+    printf("%-14s %10.1f %10.1f %10s %8.2fx\n", "shortest", reference, shortest, "-", reference / shortest);
+
+    return matched ? 0 : 1;
+}
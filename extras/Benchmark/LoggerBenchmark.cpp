@@ -0,0 +1,326 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+/**
+ * Measures the logger hot paths end to end: formatting in the logger plus the sinks' Handle.
+ *
+ *     cmake -S . -B build && cmake --build build --target spin-logger-benchmark
+ *     build/spin-logger-benchmark [records per thread] [directory for file sinks]
+ *
+ * Every sweep changes one dimension of the baseline (sync logger, one null sink, 64 byte
+ * messages, 256 byte buffer, one thread). ns/record and records/s come from the wall time of
+ * the whole run, the percentiles from timing every 8th call on its own. Async rows include
+ * the time to drain the queue.
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SPIN-Logger.hpp>
+
+static const long sampleEvery = 8;
+
+
+class NullSink : public SPIN::Log::Sinks::ISink
+{
+    private:
+        std::size_t _bytes = 0;
+
+    public:
+        void Handle(SPIN::Log::LogLevel, const char* message) override
+        {
+            this->_bytes += strlen(message);
+        }
+        void Handle(const SPIN::Log::LogRecord& record) override
+        {
+            this->_bytes += record.length;
+        }
+        void Flush() override
+        {
+        }
+};
+
+class NullBuffer : public std::streambuf
+{
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+};
+
+enum class SinkKind
+{
+    Null,
+    File,
+    Stream
+};
+
+enum class LoggerKind
+{
+    Sync,
+    Async,
+    Static
+};
+
+struct Configuration
+{
+    const char* name;
+    LoggerKind logger;
+    SinkKind sink;
+    std::size_t numberOfSinks;
+    std::size_t messageSize;
+    std::size_t threads;
+};
+
+static long recordsPerThread = 200000;
+static std::string directory = ".";
+
+
+/** Owns the sinks of one run, every kind is built the way an application would. **/
+class Sinks
+{
+    private:
+        std::vector<NullSink> _null;
+        std::vector<SPIN::Log::Sinks::FileSink> _file;
+        std::vector<SPIN::Log::Sinks::SerialSink> _stream;
+        NullBuffer _buffer;
+        std::ostream _out{ &(this->_buffer) };
+
+    public:
+        std::vector<SPIN::Log::Sinks::ISink*> pointers;
+
+        Sinks(SinkKind kind, std::size_t count)
+        {
+            this->_null.reserve(count);
+            this->_file.reserve(count);
+            this->_stream.reserve(count);
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                switch (kind)
+                {
+                    case SinkKind::Null:
+                        this->_null.emplace_back();
+                        this->pointers.push_back(&(this->_null.back()));
+                        break;
+                    case SinkKind::File:
+                    {
+                        std::string fmt = directory + "/spin-benchmark-" + std::to_string(i) + "-%03u.log";
+                        this->_file.push_back(SPIN::Log::Sinks::Factory::FileSinkFactory().SetFileNameFormatter(fmt.c_str()).Build());
+                        this->pointers.push_back(&(this->_file.back()));
+                        break;
+                    }
+                    case SinkKind::Stream:
+                        this->_stream.push_back(SPIN::Log::Sinks::Factory::SerialSinkFactory().SetStream(&(this->_out)).Build());
+                        this->pointers.push_back(&(this->_stream.back()));
+                        break;
+                }
+            }
+        }
+
+        ~Sinks()
+        {
+            std::size_t files = this->_file.size();
+            this->_file.clear();
+
+            char name[512];
+            for (std::size_t i = 0; i < files; i++)
+            {
+                for (unsigned counter = 0; counter < 16; counter++)
+                {
+                    snprintf(name, sizeof(name), "%s/spin-benchmark-%u-%03u.log", directory.c_str(), (unsigned)i, counter);
+                    remove(name);
+                }
+            }
+        }
+};
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    std::size_t index = (std::size_t)(fraction * (double)(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+template<typename Logger>
+static void Produce(Logger& logger, const Configuration& configuration)
+{
+    // The payload pads "seq=<n> payload=" out to the requested message size.
+    std::string payload(configuration.messageSize > 24 ? configuration.messageSize - 24 : 1, 'x');
+    std::vector<std::vector<uint64_t>> samples(configuration.threads);
+    std::atomic<bool> go{ false };
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < configuration.threads; t++)
+    {
+        samples[t].reserve((std::size_t)(recordsPerThread / sampleEvery + 1));
+        threads.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (long i = 0; i < recordsPerThread; i++)
+            {
+                if (i % sampleEvery != 0)
+                {
+                    logger.Information("seq=%08ld payload=%s", i, payload.c_str());
+                    continue;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                logger.Information("seq=%08ld payload=%s", i, payload.c_str());
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                samples[t].push_back((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    logger.Flush();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::vector<uint64_t> merged;
+    for (auto& threadSamples : samples)
+    {
+        merged.insert(merged.end(), threadSamples.begin(), threadSamples.end());
+    }
+    std::sort(merged.begin(), merged.end());
+
+    double records = (double)recordsPerThread * (double)(configuration.threads);
+    double nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    printf("%-30s %10.1f %12.0f %8llu %8llu %8llu %8llu %9llu\n",
+           configuration.name,
+           nanoseconds / records,
+           records * 1e9 / nanoseconds,
+           (unsigned long long)Percentile(merged, 0.50),
+           (unsigned long long)Percentile(merged, 0.90),
+           (unsigned long long)Percentile(merged, 0.99),
+           (unsigned long long)Percentile(merged, 0.999),
+           (unsigned long long)(merged.empty() ? 0 : merged.back()));
+}
+
+/** StaticLogger sinks are fixed at compile time, these rows always use four null sinks. **/
+template<std::size_t bufferSize>
+static void RunStatic(const Configuration& configuration)
+{
+    SPIN::Log::StaticLogger<bufferSize, NullSink, NullSink, NullSink, NullSink> logger{ NullSink(), NullSink(), NullSink(), NullSink() };
+
+    Produce(logger, configuration);
+}
+
+template<std::size_t bufferSize>
+static void Run(const Configuration& configuration)
+{
+    if (configuration.logger == LoggerKind::Static)
+    {
+        RunStatic<bufferSize>(configuration);
+        return;
+    }
+
+    Sinks sinks(configuration.sink, configuration.numberOfSinks);
+
+    if (configuration.logger == LoggerKind::Sync)
+    {
+        SPIN::Log::Factory::CFormattedLoggerFactory factory;
+        for (auto* sink : sinks.pointers)
+        {
+            factory.AddSink(sink);
+        }
+        auto logger = factory.SetConcurrent(configuration.threads > 1).template Build<bufferSize>();
+
+        Produce(logger, configuration);
+        return;
+    }
+
+    SPIN::Log::Factory::AsyncLoggerFactory factory;
+    for (auto* sink : sinks.pointers)
+    {
+        factory.AddSink(sink);
+    }
+    auto logger = factory.SetOverflowPolicy(SPIN::Log::OverflowPolicy::Block).template Build<bufferSize, 4096>();
+
+    logger.Start();
+    Produce(logger, configuration);
+    logger.Stop();
+}
+
+
+int main(int argc, char** argv)
+{
+    recordsPerThread = (argc > 1) ? atol(argv[1]) : recordsPerThread;
+    directory = (argc > 2) ? argv[2] : directory;
+
+    printf("%-30s %10s %12s %8s %8s %8s %8s %9s\n", "configuration", "ns/record", "records/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+
+    // Baseline, then message size.
+    Run<256>({ "size 16", LoggerKind::Sync, SinkKind::Null, 1, 16, 1 });
+    Run<256>({ "size 64", LoggerKind::Sync, SinkKind::Null, 1, 64, 1 });
+    Run<256>({ "size 200", LoggerKind::Sync, SinkKind::Null, 1, 200, 1 });
+
+    Run<128>({ "buffer 128", LoggerKind::Sync, SinkKind::Null, 1, 64, 1 });
+    Run<512>({ "buffer 512", LoggerKind::Sync, SinkKind::Null, 1, 64, 1 });
+    Run<4096>({ "buffer 4096", LoggerKind::Sync, SinkKind::Null, 1, 64, 1 });
+
+    Run<256>({ "sinks 2", LoggerKind::Sync, SinkKind::Null, 2, 64, 1 });
+    Run<256>({ "sinks 4", LoggerKind::Sync, SinkKind::Null, 4, 64, 1 });
+    Run<256>({ "sinks 4 static", LoggerKind::Static, SinkKind::Null, 4, 64, 1 });
+
+    Run<256>({ "sink file", LoggerKind::Sync, SinkKind::File, 1, 64, 1 });
+    Run<256>({ "sink ostream", LoggerKind::Sync, SinkKind::Stream, 1, 64, 1 });
+
+    Run<256>({ "threads 2", LoggerKind::Sync, SinkKind::Null, 1, 64, 2 });
+    Run<256>({ "threads 4", LoggerKind::Sync, SinkKind::Null, 1, 64, 4 });
+    Run<256>({ "threads 4 file", LoggerKind::Sync, SinkKind::File, 1, 64, 4 });
+
+    Run<256>({ "async", LoggerKind::Async, SinkKind::Null, 1, 64, 1 });
+    Run<256>({ "async threads 4", LoggerKind::Async, SinkKind::Null, 1, 64, 4 });
+    Run<256>({ "async threads 4 file", LoggerKind::Async, SinkKind::File, 1, 64, 4 });
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+/**
+ * Turns binary FileSink logs back into the text FileSink writes in text mode.
+ *
+ *     g++ -std=c++11 -I../../src SPINLogDecode.cpp ../../src/SPIN/Log/Format/ArgumentCodec.cpp \
+ *         ../../src/SPIN/Log/Format/TypedFormat.cpp ../../src/SPIN/Log/Format/NumberFormat.cpp -o spin-log-decode
+ *     spin-log-decode [-t] LOG00001.BIN [...]
+ *
+ * -t prefixes every line with the seconds elapsed since the file was opened.
+ **/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <SPIN/Log/Format/ArgumentCodec.hpp>
+#include <SPIN/Log/Format/Varint.hpp>
+
+static const char tags[6][7] = {
+    "[VER]:",
+    "[DEB]:",
+    "[INF]:",
+    "[WAR]:",
+    "[ERR]:",
+    "[FAT]:"
+};
+
+static const uint8_t binaryVersion = 1;
+static const uint8_t binaryDictionaryEntry = 0x01;
+static const uint8_t binaryFormattedRecord = 0x10;
+static const uint8_t binaryTextRecord = 0x20;
+
+
+static bool ReadFile(const char* path, std::vector<uint8_t>& contents)
+{
+    FILE* fptr = fopen(path, "rb");
+    if (fptr == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t chunk[1 << 16];
+    std::size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), fptr)) > 0)
+    {
+        contents.insert(contents.end(), chunk, chunk + read);
+    }
+    fclose(fptr);
+
+    return true;
+}
+
+static void PrintLine(bool timestamps, uint64_t base, uint64_t timestamp, uint8_t level, const char* message, std::size_t length)
+{
+    if (timestamps)
+    {
+        printf("[%12.6f] ", (double)(int64_t)(timestamp - base) / 1e6);
+    }
+    printf("%s %.*s\n", tags[level < 6 ? level : 5], (int)length, message);
+}
+
+static int Decode(const char* path, bool timestamps)
+{
+    std::vector<uint8_t> contents;
+    if (!ReadFile(path, contents))
+    {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 1;
+    }
+
+    const uint8_t* data = contents.data();
+    std::size_t length = contents.size();
+    std::size_t position = 6;
+    uint64_t base;
+
+    if (length < 6 || memcmp(data, "SPLG", 4) != 0 || data[4] != binaryVersion
+        || !SPIN::Log::Format::ReadVarint(data, length, position, base))
+    {
+        fprintf(stderr, "%s: not a version %u SPIN binary log\n", path, (unsigned)binaryVersion);
+        return 1;
+    }
+
+    std::vector<std::string> dictionary;
+    std::vector<uint8_t> native;
+    std::vector<char> rendered(1 << 16);
+    uint64_t timestamp = base;
+    bool undecodable = false;
+
+    while (position < length)
+    {
+        std::size_t start = position;
+        uint8_t kind = data[position++];
+        uint64_t value;
+        uint64_t size;
+
+        if (kind == binaryDictionaryEntry)
+        {
+            uint64_t id;
+            if (!SPIN::Log::Format::ReadVarint(data, length, position, id)
+                || !SPIN::Log::Format::ReadVarint(data, length, position, size) || position + size > length)
+            {
+                break;
+            }
+
+            if (dictionary.size() <= id)
+            {
+                dictionary.resize((std::size_t)id + 1);
+            }
+            dictionary[(std::size_t)id].assign((const char*)(data + position), (std::size_t)size);
+            position += (std::size_t)size;
+            continue;
+        }
+
+        uint8_t level = kind & 0x0F;
+        if (!SPIN::Log::Format::ReadVarint(data, length, position, value))
+        {
+            break;
+        }
+        timestamp += (uint64_t)SPIN::Log::Format::ZigZagDecode(value);
+
+        if ((kind & 0xF0) == binaryTextRecord)
+        {
+            if (!SPIN::Log::Format::ReadVarint(data, length, position, size) || position + size > length)
+            {
+                break;
+            }
+
+            PrintLine(timestamps, base, timestamp, level, (const char*)(data + position), (std::size_t)size);
+            position += (std::size_t)size;
+        }
+        else if ((kind & 0xF0) == binaryFormattedRecord)
+        {
+            uint64_t id;
+            if (!SPIN::Log::Format::ReadVarint(data, length, position, id) || id >= dictionary.size()
+                || !SPIN::Log::Format::ReadVarint(data, length, position, size) || position + size > length)
+            {
+                break;
+            }
+
+            // A one byte varint can come back as an 8 byte native value, nothing grows more than that.
+            const char* fmt = dictionary[(std::size_t)id].c_str();
+            native.resize(8 * (std::size_t)size + 64);
+            std::size_t nativeLength = SPIN::Log::Format::DecodeArguments(fmt, data + position, (std::size_t)size, native.data(), native.size());
+            if (nativeLength == 0 && size != 0)
+            {
+                fprintf(stderr, "%s: undecodable record at offset %zu\n", path, start);
+                undecodable = true;
+                position += (std::size_t)size;
+                continue;
+            }
+            std::size_t renderedLength = SPIN::Log::Format::RenderArguments(fmt, native.data(), nativeLength, rendered.data(), rendered.size());
+
+            PrintLine(timestamps, base, timestamp, level, rendered.data(), renderedLength);
+            position += (std::size_t)size;
+        }
+        else
+        {
+            fprintf(stderr, "%s: unknown entry 0x%02x at offset %zu\n", path, (unsigned)kind, position - 1);
+            return 1;
+        }
+    }
+
+    if (position < length)
+    {
+        fprintf(stderr, "%s: truncated entry at offset %zu\n", path, position);
+        return 1;
+    }
+
+    return undecodable ? 1 : 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    bool timestamps = false;
+    int result = 0;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0)
+        {
+            timestamps = true;
+            continue;
+        }
+
+        result |= Decode(argv[i], timestamps);
+        files++;
+    }
+
+    if (files == 0)
+    {
+        fprintf(stderr, "usage: %s [-t] file...\n", argv[0]);
+        return 2;
+    }
+
+    return result;
+}
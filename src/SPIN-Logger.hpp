@@ -38,12 +38,21 @@
     #include <iostream>
 #endif
 
+#include <SPIN/Log/FlushPolicy.hpp>
+#include <SPIN/Log/FlushTimer.hpp>
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/SpillPool.hpp>
+#include <SPIN/Log/StormSuppressor.hpp>
 
 #include <SPIN/Log/Sinks/ISink.hpp>
 #include <SPIN/Log/Sinks/FileSink.hpp>
 #include <SPIN/Log/Sinks/SerialSink.hpp>
+#include <SPIN/Log/Sinks/FlightRecorderSink.hpp>
 #include <SPIN/Log/ILogger.hpp>
 #include <SPIN/Log/CFormattedLogger.hpp>
+#include <SPIN/Log/AsyncLogger.hpp>
+#include <SPIN/Log/StaticLogger.hpp>
+#include <SPIN/Log/Macros.hpp>
 
 #endif/*!__LOGGER__LOGGER__H__*/
\ No newline at end of file
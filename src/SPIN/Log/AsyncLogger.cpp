@@ -0,0 +1,191 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/AsyncLogger.hpp>
+
+#ifndef ARDUINO
+
+#include <cstdlib>
+#include <cstring>
+
+
+bool SPIN::Log::Factory::AsyncLoggerFactory::DoubleCapacityIfNeeded()
+{
+    if (this->_sinks == nullptr)
+    {
+        this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(2 * sizeof(SPIN::Log::Sinks::ISink*));
+        if (this->_sinks == nullptr)
+        {
+            return false;
+        }
+        this->_sizeOfSinks = 2;
+    }
+
+    if (this->_numberOfSinks < this->_sizeOfSinks)
+    {
+        return true;
+    }
+
+    auto** temp = (SPIN::Log::Sinks::ISink**)realloc(this->_sinks, this->_sizeOfSinks * 2 * sizeof(SPIN::Log::Sinks::ISink*));
+    if (temp == nullptr)
+    {
+        return false;
+    }
+
+    this->_sinks = temp;
+    this->_sizeOfSinks *= 2;
+
+    return true;
+}
+
+
+SPIN::Log::Factory::AsyncLoggerFactory::AsyncLoggerFactory(const SPIN::Log::Factory::AsyncLoggerFactory& obj)
+{
+    *this = obj;
+}
+SPIN::Log::Factory::AsyncLoggerFactory::AsyncLoggerFactory(SPIN::Log::Factory::AsyncLoggerFactory&& deadObj) noexcept
+{
+    this->_sinks = deadObj._sinks;
+    this->_numberOfSinks = deadObj._numberOfSinks;
+    this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_deferredFormatting = deadObj._deferredFormatting;
+    this->_sinkLanes = deadObj._sinkLanes;
+    this->_overflowPolicy = deadObj._overflowPolicy;
+
+    deadObj._sinks = nullptr;
+    deadObj._numberOfSinks = 0;
+    deadObj._sizeOfSinks = 0;
+}
+
+
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::AddSink(SPIN::Log::Sinks::ISink* sink)
+{
+    if (!this->DoubleCapacityIfNeeded())
+    {
+        throw std::exception();
+    }
+
+    this->_sinks[this->_numberOfSinks++] = sink;
+
+    return *this;
+}
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+{
+    this->_minimumLevel = logLevel;
+
+    return *this;
+}
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::SetDeferredFormatting(bool deferredFormatting)
+{
+    this->_deferredFormatting = deferredFormatting;
+
+    return *this;
+}
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::SetSinkLanes(bool sinkLanes)
+{
+    this->_sinkLanes = sinkLanes;
+
+    return *this;
+}
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::SetOverflowPolicy(SPIN::Log::OverflowPolicy overflowPolicy)
+{
+    this->_overflowPolicy = overflowPolicy;
+
+    return *this;
+}
+
+
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::operator=(const SPIN::Log::Factory::AsyncLoggerFactory& obj)
+{
+    if (this == &obj)
+    {
+        return *this;
+    }
+
+    if (this->_sinks != nullptr)
+    {
+        free((void*)(this->_sinks));
+    }
+    this->_sinks = nullptr;
+    this->_numberOfSinks = 0;
+    this->_sizeOfSinks = 0;
+    this->_minimumLevel = obj._minimumLevel;
+    this->_deferredFormatting = obj._deferredFormatting;
+    this->_sinkLanes = obj._sinkLanes;
+    this->_overflowPolicy = obj._overflowPolicy;
+
+    if (obj._sizeOfSinks == 0)
+    {
+        return *this;
+    }
+
+    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._sizeOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    if (this->_sinks == nullptr)
+    {
+        throw std::exception();
+    }
+    this->_numberOfSinks = obj._numberOfSinks;
+    this->_sizeOfSinks = obj._sizeOfSinks;
+
+    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+
+    return *this;
+}
+SPIN::Log::Factory::AsyncLoggerFactory& SPIN::Log::Factory::AsyncLoggerFactory::operator=(SPIN::Log::Factory::AsyncLoggerFactory&& deadObj) noexcept
+{
+    if (this->_sinks != nullptr)
+    {
+        free((void*)(this->_sinks));
+    }
+
+    this->_sinks = deadObj._sinks;
+    this->_numberOfSinks = deadObj._numberOfSinks;
+    this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_deferredFormatting = deadObj._deferredFormatting;
+    this->_sinkLanes = deadObj._sinkLanes;
+    this->_overflowPolicy = deadObj._overflowPolicy;
+
+    deadObj._sinks = nullptr;
+    deadObj._numberOfSinks = 0;
+    deadObj._sizeOfSinks = 0;
+
+    return *this;
+}
+
+
+SPIN::Log::Factory::AsyncLoggerFactory::~AsyncLoggerFactory()
+{
+    if (this->_sinks != nullptr)
+    {
+        free((void*)(this->_sinks));
+    }
+
+    this->_sinks = nullptr;
+    this->_numberOfSinks = 0;
+    this->_sizeOfSinks = 0;
+}
+
+#endif
@@ -0,0 +1,975 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__ASYNCLOGGER__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__ASYNCLOGGER__H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <SPIN/Log/Clock.hpp>
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/OverflowPolicy.hpp>
+#include <SPIN/Log/Thread.hpp>
+#include <SPIN/Log/Sinks/ISink.hpp>
+#include <SPIN/Log/ILogger.hpp>
+#include <SPIN/Log/Concurrent/FreeList.hpp>
+#include <SPIN/Log/Concurrent/MPMCRing.hpp>
+#include <SPIN/Log/Concurrent/SPSCQueue.hpp>
+#include <SPIN/Log/Format/ArgumentCodec.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Factory
+        {
+            class AsyncLoggerFactory;
+        }
+
+        /**
+         * Progress of one sink lane. Lag runs from the log call until the sink returned, taken
+         * on the oldest record of each batch, in microseconds.
+         **/
+        struct LaneStatistics
+        {
+            std::size_t pending;
+            uint64_t handled;
+            uint64_t dropped;
+            uint64_t lastLag;
+            uint64_t maximumLag;
+        };
+
+        /**
+         * Formats on the calling thread into a slot of a lock-free ring, a background worker
+         * hands the slots to the sinks. The overflow policy decides what happens while the ring
+         * is full, every lost record is counted per level and the worker logs the counts as one
+         * Warning (Error when Error or Fatal records were lost) as soon as there is room again.
+         *
+         * With deferred formatting the caller only stores the format pointer and the raw arguments,
+         * the worker renders the text. Format strings must then outlive the logger (string literals).
+         *
+         * With sink lanes every sink gets its own queue and thread. The worker only dispatches: each
+         * record is moved out of the ring into a pooled entry, rendered once, and shared by reference
+         * count until the last lane is done with it. A lane that falls behind drops its own records
+         * (GetLaneStatistics) while the other sinks keep up, it can hold at most half of the pool.
+         **/
+        template<std::size_t bufferSize, std::size_t queueDepth>
+        class AsyncLogger : public SPIN::Log::ILogger<bufferSize>
+        {
+            private:
+                static constexpr std::size_t batchSize = (queueDepth < 64) ? queueDepth : 64;
+                static constexpr std::size_t laneDepth = queueDepth / 2;
+                static constexpr std::size_t errorHeadroom = (queueDepth / 4 > 0) ? queueDepth / 4 : 1;
+                static constexpr std::size_t overwriteAttempts = 4;
+                static constexpr std::size_t claimSpins = 64;
+                static constexpr const char* dropReportFormat = "Logger queue full, %llu records dropped (verbose %llu, debug %llu, information %llu, warning %llu, error %llu, fatal %llu)";
+
+                typedef typename SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth>::Slot Slot;
+
+                // A record handed to the lanes: the captured record, the text every lane shares and
+                // the number of lanes still holding it. Data lives in _entryData, see EntryData.
+                struct Entry
+                {
+                    std::atomic<std::size_t> references;
+                    SPIN::Log::LogRecord record;
+                    SPIN::Log::LogRecord text;
+                };
+                struct Lane
+                {
+                    SPIN::Log::Sinks::ISink* sink = nullptr;
+                    SPIN::Log::Concurrent::SPSCQueue<Entry*, laneDepth> queue;
+                    std::thread worker;
+                    std::atomic<bool> sleeping{ false };
+                    std::atomic<uint64_t> handled{ 0 };
+                    std::atomic<uint64_t> dropped{ 0 };
+                    std::atomic<uint64_t> lastLag{ 0 };
+                    std::atomic<uint64_t> maximumLag{ 0 };
+                    std::atomic<uint64_t> flushRequests{ 0 };
+                    uint64_t flushesServed = 0;
+                    std::mutex mutex;
+                    std::condition_variable wakeUp;
+                };
+                SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth> _ring;
+                bool _deferredFormatting = false;
+                Lane* _lanes = nullptr;
+                Entry* _entries = nullptr;
+                char* _entryData = nullptr;
+                SPIN::Log::Concurrent::FreeList* _freeEntries = nullptr;
+                std::atomic<bool> _lanesRunning{ false };
+                std::thread _worker;
+                std::atomic<bool> _running{ false };
+                std::atomic<bool> _sleeping{ false };
+                std::atomic<std::size_t> _claimWaiters{ 0 };
+                SPIN::Log::OverflowPolicy _overflowPolicy = SPIN::Log::OverflowPolicy::DropNewest;
+                std::atomic<uint64_t> _droppedCounts[6];
+                uint64_t _reportedDrops[6] = { 0 };
+                std::atomic<uint64_t> _flushRequests{ 0 };
+                uint64_t _flushesServed = 0;
+                std::mutex _mutex;
+                std::condition_variable _wakeUp;
+                std::condition_variable _flushed;
+                std::condition_variable _claimable;
+
+                AsyncLogger(SPIN::Log::Sinks::ISink** sinks, std::size_t numberOfSinks, SPIN::Log::LogLevel minimumLevel, bool deferredFormatting, bool sinkLanes, SPIN::Log::OverflowPolicy overflowPolicy)
+                {
+                    this->_minimumLevel = minimumLevel;
+                    this->_deferredFormatting = deferredFormatting;
+                    this->_overflowPolicy = overflowPolicy;
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        this->_droppedCounts[i].store(0, std::memory_order_relaxed);
+                    }
+
+                    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+                    if (this->_sinks == nullptr)
+                    {
+                        throw std::exception();
+                    }
+                    memcpy((void*)(this->_sinks), (const void*)sinks, numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+                    this->_numberOfSinks = numberOfSinks;
+
+                    if (sinkLanes)
+                    {
+                        this->CreateLanes();
+                    }
+
+                    this->RefreshLevels();
+                }
+
+                void CreateLanes()
+                {
+                    this->_lanes = (Lane*)malloc(this->_numberOfSinks * sizeof(Lane));
+                    this->_entries = (Entry*)malloc(queueDepth * sizeof(Entry));
+                    this->_entryData = (char*)malloc(queueDepth * this->EntrySize());
+                    this->_freeEntries = (SPIN::Log::Concurrent::FreeList*)malloc(sizeof(SPIN::Log::Concurrent::FreeList));
+                    if (this->_lanes == nullptr || this->_entries == nullptr || this->_entryData == nullptr || this->_freeEntries == nullptr)
+                    {
+                        throw std::exception();
+                    }
+
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        new (&(this->_lanes[i])) Lane();
+                        this->_lanes[i].sink = this->_sinks[i];
+                    }
+                    for (std::size_t i = 0; i < queueDepth; i++)
+                    {
+                        new (&(this->_entries[i])) Entry();
+                    }
+                    new (this->_freeEntries) SPIN::Log::Concurrent::FreeList(queueDepth);
+                }
+                void DestroyLanes()
+                {
+                    if (this->_lanes != nullptr)
+                    {
+                        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                        {
+                            this->_lanes[i].~Lane();
+                        }
+                        free((void*)(this->_lanes));
+                    }
+                    if (this->_freeEntries != nullptr)
+                    {
+                        this->_freeEntries->~FreeList();
+                        free((void*)(this->_freeEntries));
+                    }
+                    if (this->_entries != nullptr)
+                    {
+                        free((void*)(this->_entries));
+                    }
+                    if (this->_entryData != nullptr)
+                    {
+                        free((void*)(this->_entryData));
+                    }
+
+                    this->_lanes = nullptr;
+                    this->_entries = nullptr;
+                    this->_entryData = nullptr;
+                    this->_freeEntries = nullptr;
+                }
+
+                // Deferred entries keep the captured arguments for HandleDeferred next to the rendered text.
+                std::size_t EntrySize() const
+                {
+                    return this->_deferredFormatting ? 2 * bufferSize : bufferSize;
+                }
+                char* EntryData(const Entry* entry) const
+                {
+                    return this->_entryData + (std::size_t)(entry - this->_entries) * this->EntrySize();
+                }
+                void ReleaseEntry(Entry* entry)
+                {
+                    if (entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        this->_freeEntries->Push((uint32_t)(entry - this->_entries));
+                    }
+                }
+                bool PushToLane(Lane& lane, Entry* entry)
+                {
+                    // Records the policy would make a producer wait for also wait for a full lane, so does the drop report.
+                    bool waits = this->_overflowPolicy == SPIN::Log::OverflowPolicy::Block || entry->record.format == dropReportFormat
+                        || (this->_overflowPolicy == SPIN::Log::OverflowPolicy::PreserveErrors && (uint8_t)(entry->record.level) >= (uint8_t)(SPIN::Log::LogLevel::Error));
+
+                    while (!lane.queue.TryPush(entry))
+                    {
+                        if (!waits || !this->_lanesRunning.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+
+                        if (lane.sleeping.load(std::memory_order_relaxed))
+                        {
+                            lane.wakeUp.notify_one();
+                        }
+                        std::this_thread::yield();
+                    }
+
+                    return true;
+                }
+                std::size_t Dispatch()
+                {
+                    std::size_t handled = 0;
+
+                    uint32_t index;
+                    while (this->_freeEntries->TryPop(index))
+                    {
+                        Slot* slot = this->_ring.TryConsume();
+                        if (slot == nullptr)
+                        {
+                            this->_freeEntries->Push(index);
+                            break;
+                        }
+
+                        // The slot goes back to the producers right away, a slow lane only holds entries.
+                        Entry& entry = this->_entries[index];
+                        char* data = this->EntryData(&entry);
+                        entry.record = slot->record;
+                        if (slot->record.message == nullptr)
+                        {
+                            memcpy((void*)data, (const void*)(slot->data), slot->record.length);
+                            entry.text = entry.record;
+                            entry.text.length = SPIN::Log::Format::RenderArguments(slot->record.format, (const uint8_t*)data, slot->record.length, data + bufferSize, bufferSize);
+                            this->CountRendered(entry.text.length);
+                            entry.text.message = data + bufferSize;
+                        }
+                        else
+                        {
+                            memcpy((void*)data, (const void*)(slot->data), slot->record.length + 1);
+                            entry.record.message = data;
+                            entry.text = entry.record;
+                        }
+                        this->_ring.Release(slot);
+                        this->WakeProducers();
+
+                        // The dispatcher holds a reference until every lane has been offered the entry.
+                        entry.references.store(1, std::memory_order_relaxed);
+                        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                        {
+                            Lane& lane = this->_lanes[i];
+                            if (!lane.sink->Accepts(entry.record.level))
+                            {
+                                continue;
+                            }
+
+                            entry.references.fetch_add(1, std::memory_order_relaxed);
+                            if (!this->PushToLane(lane, &entry))
+                            {
+                                entry.references.fetch_sub(1, std::memory_order_relaxed);
+                                lane.dropped.fetch_add(1, std::memory_order_relaxed);
+                                continue;
+                            }
+
+                            if (lane.sleeping.load(std::memory_order_relaxed))
+                            {
+                                lane.wakeUp.notify_one();
+                            }
+                        }
+
+                        this->ReleaseEntry(&entry);
+                        handled++;
+                    }
+
+                    return handled;
+                }
+                std::size_t DrainLane(Lane& lane)
+                {
+                    std::size_t handled = 0;
+
+                    Entry* entries[batchSize];
+                    SPIN::Log::LogRecord records[batchSize];
+                    for (;;)
+                    {
+                        std::size_t count = 0;
+                        while (count < batchSize && lane.queue.TryPop(entries[count]))
+                        {
+                            count++;
+                        }
+
+                        if (count == 0)
+                        {
+                            return handled;
+                        }
+
+                        std::size_t batched = 0;
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            const Entry* entry = entries[i];
+                            if (entry->record.message == nullptr)
+                            {
+                                // Keep the order, what was batched so far goes out before the deferred record.
+                                if (batched != 0)
+                                {
+                                    lane.sink->DeliverBatch(records, batched);
+                                    batched = 0;
+                                }
+                                if (lane.sink->DeliverDeferred(entry->record.level, entry->record.timestamp, entry->record.format, (const uint8_t*)(this->EntryData(entry)), entry->record.length))
+                                {
+                                    continue;
+                                }
+                            }
+                            records[batched++] = entry->text;
+                        }
+                        if (batched != 0)
+                        {
+                            lane.sink->DeliverBatch(records, batched);
+                        }
+
+                        uint64_t lag = SPIN::Log::Clock::Microseconds() - entries[0]->record.timestamp;
+                        lane.lastLag.store(lag, std::memory_order_relaxed);
+                        if (lag > lane.maximumLag.load(std::memory_order_relaxed))
+                        {
+                            lane.maximumLag.store(lag, std::memory_order_relaxed);
+                        }
+                        lane.handled.fetch_add(count, std::memory_order_relaxed);
+
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            this->ReleaseEntry(entries[i]);
+                        }
+                        handled += count;
+                    }
+                }
+                void ServeLaneFlush(Lane& lane)
+                {
+                    uint64_t requested = lane.flushRequests.load(std::memory_order_acquire);
+                    if (requested == lane.flushesServed)
+                    {
+                        return;
+                    }
+
+                    // Everything dispatched before the request is visible now.
+                    this->DrainLane(lane);
+                    lane.sink->DeliverFlush();
+
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    lane.flushesServed = requested;
+                    this->_flushed.notify_all();
+                }
+                void RunLane(Lane* lane)
+                {
+                    while (this->_lanesRunning.load(std::memory_order_acquire))
+                    {
+                        std::size_t handled = this->DrainLane(*lane);
+                        this->ServeLaneFlush(*lane);
+
+                        if (handled != 0)
+                        {
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(lane->mutex);
+                        lane->sleeping.store(true);
+                        if (lane->queue.Size() == 0 && this->_lanesRunning.load(std::memory_order_relaxed)
+                            && lane->flushRequests.load(std::memory_order_relaxed) == lane->flushesServed)
+                        {
+                            lane->wakeUp.wait_for(lock, std::chrono::milliseconds(1));
+                        }
+                        lane->sleeping.store(false, std::memory_order_relaxed);
+                    }
+
+                    this->DrainLane(*lane);
+                    lane->sink->DeliverFlush();
+
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    lane->flushesServed = lane->flushRequests.load();
+                    this->_flushed.notify_all();
+                }
+                void StopLanes()
+                {
+                    if (this->_lanes == nullptr || !this->_lanesRunning.exchange(false))
+                    {
+                        return;
+                    }
+
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        this->_lanes[i].wakeUp.notify_one();
+                        this->_lanes[i].worker.join();
+                    }
+                }
+
+                std::size_t Drain()
+                {
+                    if (this->_lanes != nullptr)
+                    {
+                        return this->Dispatch();
+                    }
+
+                    std::size_t handled = 0;
+
+                    typename SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth>::Slot* slot;
+                    if (this->_deferredFormatting)
+                    {
+                        while ((slot = this->_ring.TryConsume()) != nullptr)
+                        {
+                            this->HandleDeferred(slot);
+                            this->_ring.Release(slot);
+                            this->WakeProducers();
+                            handled++;
+                        }
+
+                        return handled;
+                    }
+
+                    // Slots stay claimed until every sink has seen the batch, the records point into them.
+                    typename SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth>::Slot* slots[batchSize];
+                    SPIN::Log::LogRecord records[batchSize];
+                    for (;;)
+                    {
+                        std::size_t count = 0;
+                        while (count < batchSize && (slot = this->_ring.TryConsume()) != nullptr)
+                        {
+                            slots[count] = slot;
+                            records[count] = slot->record;
+                            records[count].message = slot->data;
+                            count++;
+                        }
+
+                        if (count == 0)
+                        {
+                            return handled;
+                        }
+
+                        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                        {
+                            this->_sinks[i]->DeliverBatch(records, count);
+                        }
+
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            this->_ring.Release(slots[i]);
+                        }
+                        this->WakeProducers();
+                        handled += count;
+                    }
+                }
+                void HandleDeferred(typename SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth>::Slot* slot)
+                {
+                    SPIN::Log::LogRecord& record = slot->record;
+                    const uint8_t* args = (const uint8_t*)(slot->data);
+
+                    // Typed calls are rendered by the producer even in deferred mode.
+                    if (record.message != nullptr)
+                    {
+                        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                        {
+                            if (this->_sinks[i]->Accepts(record.level))
+                            {
+                                this->_sinks[i]->Deliver(record);
+                            }
+                        }
+                        return;
+                    }
+
+                    SPIN::Log::LogRecord rendered = record;
+                    rendered.message = nullptr;
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        if (!this->_sinks[i]->Accepts(record.level)
+                            || this->_sinks[i]->DeliverDeferred(record.level, record.timestamp, record.format, args, record.length))
+                        {
+                            continue;
+                        }
+
+                        if (rendered.message == nullptr)
+                        {
+                            rendered.length = SPIN::Log::Format::RenderArguments(record.format, args, record.length, this->_buffer, bufferSize);
+                            this->CountRendered(rendered.length);
+                            rendered.message = this->_buffer;
+                        }
+                        this->_sinks[i]->Deliver(rendered);
+                    }
+                }
+                void ServeFlushRequests()
+                {
+                    uint64_t requested = this->_flushRequests.load(std::memory_order_acquire);
+                    if (requested == this->_flushesServed)
+                    {
+                        return;
+                    }
+
+                    this->Drain();
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        // Lanes flush their own sink once they caught up with the dispatch above.
+                        if (this->_lanes != nullptr)
+                        {
+                            this->_lanes[i].flushRequests.store(requested, std::memory_order_release);
+                            this->_lanes[i].wakeUp.notify_one();
+                        }
+                        else
+                        {
+                            this->_sinks[i]->DeliverFlush();
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    this->_flushesServed = requested;
+                    this->_flushed.notify_all();
+                }
+                void Run()
+                {
+                    while (this->_running.load(std::memory_order_acquire))
+                    {
+                        std::size_t handled = this->Drain();
+                        this->ReportDrops();
+                        this->ServeFlushRequests();
+
+                        if (handled != 0)
+                        {
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(this->_mutex);
+                        this->_sleeping.store(true);
+                        // With lanes the ring may also be waiting for entries the lanes still hold.
+                        if ((this->_ring.Size() == 0 || (this->_lanes != nullptr && this->_freeEntries->Empty())) && this->_running.load(std::memory_order_relaxed)
+                            && this->_flushRequests.load(std::memory_order_relaxed) == this->_flushesServed)
+                        {
+                            // Producers only notify while we sleep, the timeout bounds a missed wake up.
+                            this->_wakeUp.wait_for(lock, std::chrono::milliseconds(1));
+                        }
+                        this->_sleeping.store(false, std::memory_order_relaxed);
+                    }
+
+                    this->Drain();
+                    this->ReportDrops();
+                    this->Drain();
+                    for (std::size_t i = 0; this->_lanes == nullptr && i < this->_numberOfSinks; i++)
+                    {
+                        this->_sinks[i]->DeliverFlush();
+                    }
+
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    this->_flushesServed = this->_flushRequests.load();
+                    this->_flushed.notify_all();
+                }
+
+                void WakeWorker()
+                {
+                    if (this->_sleeping.load(std::memory_order_relaxed))
+                    {
+                        this->_wakeUp.notify_one();
+                    }
+                }
+                /**
+                 * Called after slots were released, a producer parked in ClaimWaiting retries.
+                 **/
+                void WakeProducers()
+                {
+                    if (this->_claimWaiters.load() != 0)
+                    {
+                        std::lock_guard<std::mutex> lock(this->_mutex);
+                        this->_claimable.notify_all();
+                    }
+                }
+                Slot* ClaimWaiting()
+                {
+                    Slot* slot;
+                    std::size_t spins = 0;
+                    while ((slot = this->_ring.TryClaim()) == nullptr)
+                    {
+                        // Nothing would make room for a stopped worker, and real time threads never wait.
+                        if (SPIN::Log::Thread::IsRealTime() || !this->_running.load(std::memory_order_relaxed))
+                        {
+                            return nullptr;
+                        }
+
+                        this->WakeWorker();
+                        if (spins < claimSpins)
+                        {
+                            spins++;
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        // A slow sink would keep a spinning producer busy for as long as it takes, park instead.
+                        std::unique_lock<std::mutex> lock(this->_mutex);
+                        this->_claimWaiters.fetch_add(1);
+                        slot = this->_ring.TryClaim();
+                        if (slot == nullptr && this->_running.load(std::memory_order_relaxed))
+                        {
+                            // The worker only notifies when it sees a waiter, the timeout bounds a missed wake up.
+                            this->_claimable.wait_for(lock, std::chrono::milliseconds(1));
+                        }
+                        this->_claimWaiters.fetch_sub(1);
+                        if (slot != nullptr)
+                        {
+                            break;
+                        }
+                    }
+
+                    return slot;
+                }
+                Slot* ClaimOverwriting()
+                {
+                    for (std::size_t attempt = 0; attempt < overwriteAttempts; attempt++)
+                    {
+                        Slot* slot = this->_ring.TryClaim();
+                        if (slot != nullptr)
+                        {
+                            return slot;
+                        }
+
+                        // Slots the worker already holds cannot be taken, the attempts bound that case.
+                        Slot* oldest = this->_ring.TryConsume();
+                        if (oldest != nullptr)
+                        {
+                            this->_droppedCounts[(uint8_t)(oldest->record.level)].fetch_add(1, std::memory_order_relaxed);
+                            this->_ring.Release(oldest);
+                        }
+                    }
+
+                    return nullptr;
+                }
+                Slot* Claim(SPIN::Log::LogLevel logLevel)
+                {
+                    Slot* slot = nullptr;
+                    switch (this->_overflowPolicy)
+                    {
+                        case SPIN::Log::OverflowPolicy::DropNewest:
+                            slot = this->_ring.TryClaim();
+                            break;
+                        case SPIN::Log::OverflowPolicy::Block:
+                            slot = this->ClaimWaiting();
+                            break;
+                        case SPIN::Log::OverflowPolicy::OverwriteOldest:
+                            slot = this->ClaimOverwriting();
+                            break;
+                        case SPIN::Log::OverflowPolicy::PreserveErrors:
+                            if ((uint8_t)logLevel >= (uint8_t)(SPIN::Log::LogLevel::Error))
+                            {
+                                slot = this->ClaimWaiting();
+                            }
+                            else if (this->_ring.Size() + errorHeadroom < queueDepth)
+                            {
+                                slot = this->_ring.TryClaim();
+                            }
+                            break;
+                    }
+
+                    if (slot == nullptr)
+                    {
+                        this->_droppedCounts[(uint8_t)logLevel].fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    return slot;
+                }
+                void ReportDrops()
+                {
+                    SPIN::Log::Format::Argument arguments[7];
+                    uint64_t dropped[6];
+                    uint64_t total = 0;
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        dropped[i] = this->_droppedCounts[i].load(std::memory_order_relaxed) - this->_reportedDrops[i];
+                        arguments[i + 1] = SPIN::Log::Format::MakeArgument((unsigned long long)dropped[i]);
+                        total += dropped[i];
+                    }
+                    // Under pressure the counts keep growing, one report follows once half the ring is free.
+                    if (total == 0 || this->_ring.Size() > queueDepth / 2 || (this->_freeEntries != nullptr && this->_freeEntries->Empty()))
+                    {
+                        return;
+                    }
+
+                    Slot* slot = this->_ring.TryClaim();
+                    if (slot == nullptr)
+                    {
+                        return;
+                    }
+
+                    bool severe = dropped[(uint8_t)(SPIN::Log::LogLevel::Error)] + dropped[(uint8_t)(SPIN::Log::LogLevel::Fatal)] != 0;
+                    arguments[0] = SPIN::Log::Format::MakeArgument((unsigned long long)total);
+
+                    slot->record = SPIN::Log::ILogger<bufferSize>::MakeRecord(SPIN_LOG_SOURCE_LOCATION, severe ? SPIN::Log::LogLevel::Error : SPIN::Log::LogLevel::Warning, dropReportFormat);
+                    slot->record.length = SPIN::Log::Format::FormatArguments(slot->data, bufferSize, dropReportFormat, arguments, 7);
+                    slot->record.message = slot->data;
+                    this->_ring.Publish(slot);
+
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        this->_reportedDrops[i] += dropped[i];
+                    }
+                }
+
+                friend class SPIN::Log::Factory::AsyncLoggerFactory;
+
+            protected:
+                void LogExpansion(SPIN::Log::LogRecord& record, va_list args)
+                {
+                    Slot* slot = this->Claim(record.level);
+                    if (slot == nullptr)
+                    {
+                        return;
+                    }
+
+                    slot->record = record;
+                    std::size_t captured = SPIN::Log::Format::Uncapturable;
+                    if (this->_deferredFormatting)
+                    {
+                        va_list capture;
+                        va_copy(capture, args);
+                        captured = SPIN::Log::Format::CaptureArguments(record.format, capture, (uint8_t*)(slot->data), bufferSize);
+                        va_end(capture);
+                    }
+                    if (captured != SPIN::Log::Format::Uncapturable)
+                    {
+                        slot->record.length = captured;
+                    }
+                    else
+                    {
+                        slot->record.length = SPIN::Log::Format::FormatArgumentList(slot->data, bufferSize, record.format, args);
+                        this->CountRendered(slot->record.length);
+                        slot->record.message = slot->data;
+                    }
+                    this->_ring.Publish(slot);
+
+                    this->WakeWorker();
+                }
+                void LogArguments(SPIN::Log::LogRecord& record, const SPIN::Log::Format::Argument* arguments, std::size_t count)
+                {
+                    Slot* slot = this->Claim(record.level);
+                    if (slot == nullptr)
+                    {
+                        return;
+                    }
+
+                    slot->record = record;
+                    slot->record.length = SPIN::Log::Format::FormatArguments(slot->data, bufferSize, record.format, arguments, count);
+                    this->CountRendered(slot->record.length);
+                    slot->record.message = slot->data;
+                    this->_ring.Publish(slot);
+
+                    this->WakeWorker();
+                }
+
+            public:
+                AsyncLogger(const AsyncLogger<bufferSize, queueDepth>&) = delete;
+                AsyncLogger(AsyncLogger<bufferSize, queueDepth>&& deadObj) noexcept
+                    : SPIN::Log::ILogger<bufferSize>(static_cast<SPIN::Log::ILogger<bufferSize>&&>(deadObj)),
+                      _ring(static_cast<SPIN::Log::Concurrent::MPMCRing<bufferSize, queueDepth>&&>(deadObj._ring))
+                {
+                    this->_deferredFormatting = deadObj._deferredFormatting;
+                    this->_overflowPolicy = deadObj._overflowPolicy;
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        this->_droppedCounts[i].store(deadObj._droppedCounts[i].load());
+                        this->_reportedDrops[i] = deadObj._reportedDrops[i];
+                    }
+                    this->_lanes = deadObj._lanes;
+                    this->_entries = deadObj._entries;
+                    this->_entryData = deadObj._entryData;
+                    this->_freeEntries = deadObj._freeEntries;
+
+                    deadObj._lanes = nullptr;
+                    deadObj._entries = nullptr;
+                    deadObj._entryData = nullptr;
+                    deadObj._freeEntries = nullptr;
+                }
+
+                void Start()
+                {
+                    if (this->_running.exchange(true))
+                    {
+                        return;
+                    }
+
+                    if (this->_lanes != nullptr)
+                    {
+                        this->_lanesRunning.store(true);
+                        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                        {
+                            this->_lanes[i].worker = std::thread(&AsyncLogger<bufferSize, queueDepth>::RunLane, this, &(this->_lanes[i]));
+                        }
+                    }
+                    this->_worker = std::thread(&AsyncLogger<bufferSize, queueDepth>::Run, this);
+                }
+                void Stop()
+                {
+                    if (!this->_running.exchange(false))
+                    {
+                        return;
+                    }
+
+                    this->_wakeUp.notify_one();
+                    this->_worker.join();
+                    this->StopLanes();
+                    this->WakeProducers();
+                }
+
+                void Flush() override
+                {
+                    this->ReportSuppressed();
+                    if (!this->_running.load(std::memory_order_acquire))
+                    {
+                        this->Drain();
+                        this->ReportDrops();
+                        this->Drain();
+                        for (std::size_t i = 0; this->_lanes != nullptr && i < this->_numberOfSinks; i++)
+                        {
+                            this->DrainLane(this->_lanes[i]);
+                        }
+                        SPIN::Log::ILogger<bufferSize>::Flush();
+                        return;
+                    }
+
+                    uint64_t request = this->_flushRequests.fetch_add(1) + 1;
+
+                    std::unique_lock<std::mutex> lock(this->_mutex);
+                    this->_wakeUp.notify_one();
+                    this->_flushed.wait(lock, [this, request]() {
+                        return this->_flushesServed >= request || !this->_running.load(std::memory_order_relaxed);
+                    });
+                    this->_flushed.wait(lock, [this, request]() {
+                        for (std::size_t i = 0; this->_lanes != nullptr && i < this->_numberOfSinks; i++)
+                        {
+                            if (this->_lanes[i].flushesServed < request && this->_lanesRunning.load(std::memory_order_relaxed))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    });
+                }
+
+                uint64_t GetDroppedCount() const
+                {
+                    uint64_t dropped = 0;
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        dropped += this->_droppedCounts[i].load(std::memory_order_relaxed);
+                    }
+
+                    return dropped;
+                }
+                uint64_t GetDroppedCount(SPIN::Log::LogLevel logLevel) const
+                {
+                    return this->_droppedCounts[(uint8_t)logLevel].load(std::memory_order_relaxed);
+                }
+                std::size_t GetPendingCount() const
+                {
+                    return this->_ring.Size();
+                }
+                SPIN::Log::LaneStatistics GetLaneStatistics(std::size_t sink) const
+                {
+                    SPIN::Log::LaneStatistics statistics = { 0, 0, 0, 0, 0 };
+                    if (this->_lanes == nullptr || sink >= this->_numberOfSinks)
+                    {
+                        return statistics;
+                    }
+
+                    const Lane& lane = this->_lanes[sink];
+                    statistics.pending = lane.queue.Size();
+                    statistics.handled = lane.handled.load(std::memory_order_relaxed);
+                    statistics.dropped = lane.dropped.load(std::memory_order_relaxed);
+                    statistics.lastLag = lane.lastLag.load(std::memory_order_relaxed);
+                    statistics.maximumLag = lane.maximumLag.load(std::memory_order_relaxed);
+
+                    return statistics;
+                }
+
+                AsyncLogger<bufferSize, queueDepth>& operator=(const AsyncLogger<bufferSize, queueDepth>&) = delete;
+                AsyncLogger<bufferSize, queueDepth>& operator=(AsyncLogger<bufferSize, queueDepth>&&) = delete;
+
+                ~AsyncLogger()
+                {
+                    this->Stop();
+                    this->DestroyLanes();
+                }
+        };
+
+        namespace Factory
+        {
+            class AsyncLoggerFactory
+            {
+                private:
+                    SPIN::Log::Sinks::ISink** _sinks = nullptr;
+                    std::size_t _numberOfSinks = 0;
+                    std::size_t _sizeOfSinks = 0;
+                    SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+                    bool _deferredFormatting = false;
+                    bool _sinkLanes = false;
+                    SPIN::Log::OverflowPolicy _overflowPolicy = SPIN::Log::OverflowPolicy::DropNewest;
+
+                    bool DoubleCapacityIfNeeded();
+                public:
+                    AsyncLoggerFactory() = default;
+                    AsyncLoggerFactory(const AsyncLoggerFactory&);
+                    AsyncLoggerFactory(AsyncLoggerFactory&&) noexcept;
+
+                    AsyncLoggerFactory& AddSink(SPIN::Log::Sinks::ISink*);
+                    AsyncLoggerFactory& SetMinimumLevel(SPIN::Log::LogLevel);
+                    AsyncLoggerFactory& SetDeferredFormatting(bool);
+                    AsyncLoggerFactory& SetSinkLanes(bool);
+                    AsyncLoggerFactory& SetOverflowPolicy(SPIN::Log::OverflowPolicy);
+
+                    template<std::size_t bufferSize, std::size_t queueDepth>
+                    SPIN::Log::AsyncLogger<bufferSize, queueDepth> Build()
+                    {
+                        return SPIN::Log::AsyncLogger<bufferSize, queueDepth>(_sinks, _numberOfSinks, _minimumLevel, _deferredFormatting, _sinkLanes, _overflowPolicy);
+                    }
+
+                    AsyncLoggerFactory& operator=(const AsyncLoggerFactory&);
+                    AsyncLoggerFactory& operator=(AsyncLoggerFactory&&) noexcept;
+
+                    ~AsyncLoggerFactory();
+            };
+        }
+    }
+}
+
+#endif
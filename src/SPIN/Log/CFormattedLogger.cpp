@@ -45,7 +45,7 @@ bool SPIN::Log::Factory::CFormattedLoggerFactory::DoubleCapacityIfNeeded()
         this->_sizeOfSinks = 2;
     }
 
-    if (this->_numberOfSinks <= this->_sizeOfSinks)
+    if (this->_numberOfSinks < this->_sizeOfSinks)
     {
         return true;
     }
@@ -57,7 +57,7 @@ bool SPIN::Log::Factory::CFormattedLoggerFactory::DoubleCapacityIfNeeded()
     }
 
     this->_sinks = temp;
-    this->_numberOfSinks *= 2;
+    this->_sizeOfSinks *= 2;
 
     return true;
 }
@@ -65,7 +65,7 @@ bool SPIN::Log::Factory::CFormattedLoggerFactory::DoubleCapacityIfNeeded()
 
 SPIN::Log::Factory::CFormattedLoggerFactory::CFormattedLoggerFactory(const SPIN::Log::Factory::CFormattedLoggerFactory& obj)
 {
-    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._sizeOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
     if (this->_sinks == nullptr)
     {
 #ifndef ARDUINO
@@ -75,14 +75,20 @@ SPIN::Log::Factory::CFormattedLoggerFactory::CFormattedLoggerFactory(const SPIN:
     }
     this->_numberOfSinks = obj._numberOfSinks;
     this->_sizeOfSinks = obj._sizeOfSinks;
+    this->_minimumLevel = obj._minimumLevel;
+    this->_concurrent = obj._concurrent;
+    this->_spillPool = obj._spillPool;
 
-    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._sizeOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
 }
 SPIN::Log::Factory::CFormattedLoggerFactory::CFormattedLoggerFactory(SPIN::Log::Factory::CFormattedLoggerFactory&& deadObj) noexcept
 {
     this->_sinks = deadObj._sinks;
     this->_numberOfSinks = deadObj._numberOfSinks;
     this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_concurrent = deadObj._concurrent;
+    this->_spillPool = deadObj._spillPool;
 
     deadObj._sinks = nullptr;
     deadObj._numberOfSinks = 0;
@@ -104,11 +110,29 @@ SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLogge
 
     return *this;
 }
+SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLoggerFactory::SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+{
+    this->_minimumLevel = logLevel;
+
+    return *this;
+}
+SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLoggerFactory::SetConcurrent(bool concurrent)
+{
+    this->_concurrent = concurrent;
+
+    return *this;
+}
+SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLoggerFactory::SetSpillPool(SPIN::Log::SpillPool* spillPool)
+{
+    this->_spillPool = spillPool;
+
+    return *this;
+}
 
 
 SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLoggerFactory::operator=(const SPIN::Log::Factory::CFormattedLoggerFactory& obj)
 {
-    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._sizeOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
     if (this->_sinks == nullptr)
     {
 #ifndef ARDUINO
@@ -118,8 +142,11 @@ SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLogge
     }
     this->_numberOfSinks = obj._numberOfSinks;
     this->_sizeOfSinks = obj._sizeOfSinks;
+    this->_minimumLevel = obj._minimumLevel;
+    this->_concurrent = obj._concurrent;
+    this->_spillPool = obj._spillPool;
 
-    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._sizeOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
 
     return *this;
 }
@@ -128,6 +155,9 @@ SPIN::Log::Factory::CFormattedLoggerFactory& SPIN::Log::Factory::CFormattedLogge
     this->_sinks = deadObj._sinks;
     this->_numberOfSinks = deadObj._numberOfSinks;
     this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_concurrent = deadObj._concurrent;
+    this->_spillPool = deadObj._spillPool;
 
     deadObj._sinks = nullptr;
     deadObj._numberOfSinks = 0;
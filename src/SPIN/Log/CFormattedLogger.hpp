@@ -41,24 +41,41 @@
 #endif
 
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
 #include <SPIN/Log/Sinks/ISink.hpp>
 #include <SPIN/Log/ILogger.hpp>
+#include <SPIN/Log/SpillPool.hpp>
 
 namespace SPIN
 {
     namespace Log
     {
+        class SpillPool;
+
         namespace Factory
         {
             class CFormattedLoggerFactory;
         }
 
+        /**
+         * In concurrent mode every call formats into its own stack buffer and each sink is
+         * locked only while it handles the line, so several threads can share one logger.
+         * With a spill pool, a line that does not fit the buffer is rendered again into a
+         * pooled buffer large enough for it instead of being cut.
+         **/
         template<std::size_t bufferSize>
         class CFormattedLogger : public SPIN::Log::ILogger<bufferSize>
         {
             private:
-                CFormattedLogger(SPIN::Log::Sinks::ISink** sinks, std::size_t numberOfSinks)
+                bool _concurrent = false;
+                SPIN::Log::SpillPool* _spillPool = nullptr;
+
+                CFormattedLogger(SPIN::Log::Sinks::ISink** sinks, std::size_t numberOfSinks, SPIN::Log::LogLevel minimumLevel, bool concurrent, SPIN::Log::SpillPool* spillPool)
                 {
+                    this->_minimumLevel = minimumLevel;
+                    this->_concurrent = concurrent;
+                    this->_spillPool = spillPool;
+
                     this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
                     if (this->_sinks == nullptr)
                     {
@@ -69,20 +86,175 @@ namespace SPIN
                     }
                     memcpy((void*)(this->_sinks), (const void*)sinks, numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
                     this->_numberOfSinks = numberOfSinks;
+
+                    this->RefreshLevels();
                 }
 
                 friend class SPIN::Log::Factory::CFormattedLoggerFactory;
 
             protected:
-                void LogExpansion(SPIN::Log::LogLevel logLevel, const char* fmt, va_list args)
+                static std::size_t Render(char* buffer, const char* fmt, va_list args, std::size_t& required)
                 {
-                    vsnprintf(this->_buffer, bufferSize, fmt, args);
+                    return SPIN::Log::Format::FormatArgumentList(buffer, bufferSize, fmt, args, required);
+                }
 
+                void HandleAll(const SPIN::Log::LogRecord& record)
+                {
                     for (std::size_t i = 0; i < this->_numberOfSinks; i++)
                     {
-                        this->_sinks[i]->Handle(logLevel, this->_buffer);
+                        if (!this->_sinks[i]->Accepts(record.level))
+                        {
+                            continue;
+                        }
+
+                        if (this->_concurrent)
+                        {
+                            this->_sinks[i]->Lock();
+                            this->_sinks[i]->Deliver(record);
+                            this->_sinks[i]->Unlock();
+                        }
+                        else
+                        {
+                            this->_sinks[i]->Deliver(record);
+                        }
+                    }
+                }
+
+                void LogExpansion(SPIN::Log::LogRecord& record, va_list args)
+                {
+                    std::size_t required;
+                    if (this->_concurrent)
+                    {
+                        char buffer[bufferSize];
+                        SPIN::Log::LogRecord rendered = record;
+                        rendered.length = Render(buffer, record.format, args, required);
+                        rendered.message = buffer;
+
+                        if (!this->SpillExpansion(rendered, required, args))
+                        {
+                            this->CountRendered(rendered.length);
+                            this->HandleAll(rendered);
+                        }
+                        return;
+                    }
+
+                    record.length = Render(this->_buffer, record.format, args, required);
+                    record.message = this->_buffer;
+
+                    if (!this->SpillExpansion(record, required, args))
+                    {
+                        this->CountRendered(record.length);
+                        this->HandleAll(record);
+                    }
+                }
+                void LogArguments(SPIN::Log::LogRecord& record, const SPIN::Log::Format::Argument* arguments, std::size_t count)
+                {
+                    std::size_t required;
+                    if (this->_concurrent)
+                    {
+                        char buffer[bufferSize];
+                        SPIN::Log::LogRecord rendered = record;
+                        rendered.length = SPIN::Log::Format::FormatArguments(buffer, bufferSize, record.format, arguments, count, required);
+                        rendered.message = buffer;
+
+                        if (!this->SpillArguments(rendered, required, arguments, count))
+                        {
+                            this->CountRendered(rendered.length);
+                            this->HandleAll(rendered);
+                        }
+                        return;
+                    }
+
+                    record.length = SPIN::Log::Format::FormatArguments(this->_buffer, bufferSize, record.format, arguments, count, required);
+                    record.message = this->_buffer;
+
+                    if (!this->SpillArguments(record, required, arguments, count))
+                    {
+                        this->CountRendered(record.length);
+                        this->HandleAll(record);
                     }
                 }
+                /**
+                 * Renders a line that did not fit again into a pooled buffer and hands it to the
+                 * sinks. Returns false when there is nothing to spill or no buffer is free, the
+                 * cut line is then logged as before.
+                 **/
+                bool SpillExpansion(SPIN::Log::LogRecord& record, std::size_t required, va_list args)
+                {
+#ifndef ARDUINO
+                    SPIN::Log::SpillPool::Buffer spill;
+                    if (required < bufferSize || this->_spillPool == nullptr || !this->_spillPool->Acquire(required + 1, spill))
+                    {
+                        return false;
+                    }
+
+                    SPIN::Log::LogRecord rendered = record;
+                    rendered.length = SPIN::Log::Format::FormatArgumentList(spill.data, spill.size, record.format, args);
+                    rendered.message = spill.data;
+                    this->HandleAll(rendered);
+
+                    this->_spillPool->Release(spill);
+                    return true;
+#else
+                    (void)record;
+                    (void)required;
+                    (void)args;
+                    return false;
+#endif
+                }
+                bool SpillArguments(SPIN::Log::LogRecord& record, std::size_t required, const SPIN::Log::Format::Argument* arguments, std::size_t count)
+                {
+#ifndef ARDUINO
+                    SPIN::Log::SpillPool::Buffer spill;
+                    if (required < bufferSize || this->_spillPool == nullptr || !this->_spillPool->Acquire(required + 1, spill))
+                    {
+                        return false;
+                    }
+
+                    SPIN::Log::LogRecord rendered = record;
+                    rendered.length = SPIN::Log::Format::FormatArguments(spill.data, spill.size, record.format, arguments, count);
+                    rendered.message = spill.data;
+                    this->HandleAll(rendered);
+
+                    this->_spillPool->Release(spill);
+                    return true;
+#else
+                    (void)record;
+                    (void)required;
+                    (void)arguments;
+                    (void)count;
+                    return false;
+#endif
+                }
+
+            public:
+                void Flush() override
+                {
+                    if (!this->_concurrent)
+                    {
+                        SPIN::Log::ILogger<bufferSize>::Flush();
+                        return;
+                    }
+
+                    this->ReportSuppressed();
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        this->_sinks[i]->Lock();
+                        this->_sinks[i]->DeliverFlush();
+                        this->_sinks[i]->Unlock();
+                    }
+                }
+
+                uint64_t GetContentionCount() const
+                {
+                    uint64_t contentions = 0;
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        contentions += this->_sinks[i]->GetContentionCount();
+                    }
+
+                    return contentions;
+                }
         };
 
         namespace Factory
@@ -93,6 +265,9 @@ namespace SPIN
                     SPIN::Log::Sinks::ISink** _sinks = nullptr;
                     std::size_t _numberOfSinks = 0;
                     std::size_t _sizeOfSinks = 0;
+                    SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+                    bool _concurrent = false;
+                    SPIN::Log::SpillPool* _spillPool = nullptr;
 
                     bool DoubleCapacityIfNeeded();
                 public:
@@ -101,11 +276,15 @@ namespace SPIN
                     CFormattedLoggerFactory(CFormattedLoggerFactory&&) noexcept;
 
                     CFormattedLoggerFactory& AddSink(SPIN::Log::Sinks::ISink*);
+                    CFormattedLoggerFactory& SetMinimumLevel(SPIN::Log::LogLevel);
+                    CFormattedLoggerFactory& SetConcurrent(bool);
+                    /** Pool for lines longer than the buffer, it must outlive the logger. **/
+                    CFormattedLoggerFactory& SetSpillPool(SPIN::Log::SpillPool*);
 
                     template<std::size_t bufferSize>
                     SPIN::Log::CFormattedLogger<bufferSize> Build()
                     {
-                        return SPIN::Log::CFormattedLogger<bufferSize>(_sinks, _numberOfSinks);
+                        return SPIN::Log::CFormattedLogger<bufferSize>(_sinks, _numberOfSinks, _minimumLevel, _concurrent, _spillPool);
                     }
 
                     CFormattedLoggerFactory& operator=(const CFormattedLoggerFactory&);
@@ -0,0 +1,280 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Clock.hpp>
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <atomic>
+    #include <chrono>
+#endif
+
+#ifdef __LOGGER__SPIN__LOG__CLOCK__TSC__
+    #include <cpuid.h>
+    #include <x86intrin.h>
+#endif
+
+
+#ifdef ARDUINO
+static int64_t wallOffset = 0;
+#else
+static std::atomic<int64_t> wallOffset{ 0 };
+static std::atomic<bool> wallOffsetSet{ false };
+
+static uint64_t SteadyMicroseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static uint64_t SteadyNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#ifdef __LOGGER__SPIN__LOG__CLOCK__TSC__
+/**
+ * Microseconds = baseMicroseconds + ((tsc - baseTicks) * multiplier) >> 32, nanoseconds scale
+ * the same way. The anchor is first measured over a couple of milliseconds and re-anchored
+ * every second, with the rate refined over the whole run and slewed so the clock converges
+ * back on steady_clock without ever stepping.
+ **/
+struct TscAnchor
+{
+    uint64_t baseTicks;
+    uint64_t baseMicroseconds;
+    uint64_t baseNanoseconds;
+    uint64_t multiplier;
+    uint64_t nanosecondMultiplier;
+    uint64_t periodTicks;
+};
+class TscCalibration
+{
+    private:
+        static const uint64_t period = 1000000;
+
+        // A sequence lock, odd while the anchor is being replaced.
+        std::atomic<uint64_t> _sequence{ 0 };
+        std::atomic<uint64_t> _baseTicks{ 0 };
+        std::atomic<uint64_t> _baseMicroseconds{ 0 };
+        std::atomic<uint64_t> _baseNanoseconds{ 0 };
+        std::atomic<uint64_t> _multiplier{ 0 };
+        std::atomic<uint64_t> _nanosecondMultiplier{ 0 };
+        std::atomic<uint64_t> _periodTicks{ 0 };
+        uint64_t _originTicks = 0;
+        uint64_t _originMicroseconds = 0;
+
+        // Sets the anchor at the given reading, so that it reaches steady_clock again in a period.
+        void Store(uint64_t ticks, uint64_t microseconds, uint64_t nanoseconds, uint64_t steady)
+        {
+            unsigned __int128 rate = (((unsigned __int128)(steady - this->_originMicroseconds)) << 32) / (ticks - this->_originTicks);
+            int64_t error = (int64_t)steady - (int64_t)microseconds;
+            if (error > (int64_t)period / 2)
+            {
+                error = (int64_t)period / 2;
+            }
+            else if (error < -(int64_t)period / 2)
+            {
+                error = -(int64_t)period / 2;
+            }
+            unsigned __int128 slewed = rate * (uint64_t)((int64_t)period + error) / period;
+
+            this->_baseTicks.store(ticks, std::memory_order_relaxed);
+            this->_baseMicroseconds.store(microseconds, std::memory_order_relaxed);
+            this->_baseNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+            this->_multiplier.store((uint64_t)slewed, std::memory_order_relaxed);
+            this->_nanosecondMultiplier.store((uint64_t)(slewed * 1000), std::memory_order_relaxed);
+            this->_periodTicks.store((uint64_t)((((unsigned __int128)period) << 32) / rate), std::memory_order_relaxed);
+        }
+
+    public:
+        bool invariant = false;
+
+        TscCalibration()
+        {
+            // Without an invariant TSC the tick rate follows frequency scaling and sleep states.
+            unsigned int eax, ebx, ecx, edx;
+            this->invariant = __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1u << 8)) != 0;
+            if (!this->invariant)
+            {
+                return;
+            }
+
+            this->_originMicroseconds = SteadyMicroseconds();
+            this->_originTicks = __rdtsc();
+
+            uint64_t endMicroseconds;
+            do
+            {
+                endMicroseconds = SteadyMicroseconds();
+            } while (endMicroseconds - this->_originMicroseconds < 2000);
+            uint64_t endTicks = __rdtsc();
+
+            this->Store(endTicks, endMicroseconds, (endMicroseconds - this->_originMicroseconds) * 1000, endMicroseconds);
+        }
+
+        uint64_t Read(TscAnchor& anchor) const
+        {
+            while (true)
+            {
+                uint64_t sequence = this->_sequence.load(std::memory_order_acquire);
+                if ((sequence & 1) != 0)
+                {
+                    continue;
+                }
+
+                anchor.baseTicks = this->_baseTicks.load(std::memory_order_relaxed);
+                anchor.baseMicroseconds = this->_baseMicroseconds.load(std::memory_order_relaxed);
+                anchor.baseNanoseconds = this->_baseNanoseconds.load(std::memory_order_relaxed);
+                anchor.multiplier = this->_multiplier.load(std::memory_order_relaxed);
+                anchor.nanosecondMultiplier = this->_nanosecondMultiplier.load(std::memory_order_relaxed);
+                anchor.periodTicks = this->_periodTicks.load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (this->_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return sequence;
+                }
+            }
+        }
+        /**
+         * Called by a reader that found the anchor a period old, one of them wins and the rest
+         * keep using the anchor they read.
+         **/
+        void Reanchor(uint64_t sequence, const TscAnchor& anchor)
+        {
+            if (!this->_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            uint64_t steady = SteadyMicroseconds();
+            uint64_t ticks = __rdtsc();
+            uint64_t elapsed = (ticks > anchor.baseTicks) ? ticks - anchor.baseTicks : 0;
+            this->Store(ticks,
+                        anchor.baseMicroseconds + (uint64_t)(((unsigned __int128)elapsed * anchor.multiplier) >> 32),
+                        anchor.baseNanoseconds + (uint64_t)(((unsigned __int128)elapsed * anchor.nanosecondMultiplier) >> 32),
+                        steady);
+
+            this->_sequence.store(sequence + 2, std::memory_order_release);
+        }
+};
+static TscCalibration& Calibration()
+{
+    static TscCalibration calibration;
+
+    return calibration;
+}
+// Ticks since the anchor, re-anchoring once they cover a period.
+static uint64_t ElapsedTicks(TscAnchor& anchor)
+{
+    TscCalibration& calibration = Calibration();
+    uint64_t sequence = calibration.Read(anchor);
+    uint64_t ticks = __rdtsc();
+    if (ticks <= anchor.baseTicks)
+    {
+        return 0;
+    }
+
+    uint64_t elapsed = ticks - anchor.baseTicks;
+    if (elapsed >= anchor.periodTicks)
+    {
+        calibration.Reanchor(sequence, anchor);
+    }
+
+    return elapsed;
+}
+#endif
+
+
+uint64_t SPIN::Log::Clock::Microseconds()
+{
+#if defined(ARDUINO)
+    static uint32_t last = 0;
+    static uint64_t wraps = 0;
+
+    uint32_t now = micros();
+    if (now < last)
+    {
+        wraps += (uint64_t)1 << 32;
+    }
+    last = now;
+
+    return wraps + now;
+#elif defined(__LOGGER__SPIN__LOG__CLOCK__TSC__)
+    if (!Calibration().invariant)
+    {
+        return SteadyMicroseconds();
+    }
+
+    TscAnchor anchor;
+    uint64_t elapsed = ElapsedTicks(anchor);
+
+    return anchor.baseMicroseconds + (uint64_t)(((unsigned __int128)elapsed * anchor.multiplier) >> 32);
+#else
+    return SteadyMicroseconds();
+#endif
+}
+uint64_t SPIN::Log::Clock::Nanoseconds()
+{
+#if defined(ARDUINO)
+    return SPIN::Log::Clock::Microseconds() * 1000;
+#elif defined(__LOGGER__SPIN__LOG__CLOCK__TSC__)
+    if (!Calibration().invariant)
+    {
+        return SteadyNanoseconds();
+    }
+
+    TscAnchor anchor;
+    uint64_t elapsed = ElapsedTicks(anchor);
+
+    return anchor.baseNanoseconds + (uint64_t)(((unsigned __int128)elapsed * anchor.nanosecondMultiplier) >> 32);
+#else
+    return SteadyNanoseconds();
+#endif
+}
+uint64_t SPIN::Log::Clock::WallMicroseconds(uint64_t monotonic)
+{
+#ifdef ARDUINO
+    return (uint64_t)((int64_t)monotonic + wallOffset);
+#else
+    if (!wallOffsetSet.load(std::memory_order_acquire))
+    {
+        uint64_t wall = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        SPIN::Log::Clock::SetWallClock(wall);
+    }
+
+    return (uint64_t)((int64_t)monotonic + wallOffset.load(std::memory_order_relaxed));
+#endif
+}
+void SPIN::Log::Clock::SetWallClock(uint64_t wall)
+{
+#ifdef ARDUINO
+    wallOffset = (int64_t)wall - (int64_t)SPIN::Log::Clock::Microseconds();
+#else
+    wallOffset.store((int64_t)wall - (int64_t)SPIN::Log::Clock::Microseconds(), std::memory_order_relaxed);
+    wallOffsetSet.store(true, std::memory_order_release);
+#endif
+}
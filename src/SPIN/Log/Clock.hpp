@@ -0,0 +1,68 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__CLOCK__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__CLOCK__H__
+
+#ifdef ARDUINO
+    #include <stdint.h>
+#else
+    #include <cstdint>
+#endif
+
+/**
+ * On x86-64 hosts with an invariant TSC the monotonic clock reads the TSC and scales it with a
+ * factor kept in step with steady_clock, define SPIN_LOG_NO_TSC to always use steady_clock instead.
+ **/
+#if !defined(ARDUINO) && !defined(SPIN_LOG_NO_TSC) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #define __LOGGER__SPIN__LOG__CLOCK__TSC__
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Clock
+        {
+            /**
+             * Monotonic microseconds, the time base of every record timestamp.
+             **/
+            uint64_t Microseconds();
+            /**
+             * Monotonic nanoseconds for measuring short intervals, same source as Microseconds.
+             **/
+            uint64_t Nanoseconds();
+
+            /**
+             * Converts a monotonic timestamp to microseconds since the Unix epoch. The offset is
+             * taken from the system clock once, or set with SetWallClock (e.g. from an RTC or GPS
+             * on boards without one).
+             **/
+            uint64_t WallMicroseconds(uint64_t);
+            void SetWallClock(uint64_t);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__CONCURRENT__FREELIST__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__CONCURRENT__FREELIST__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <new>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Concurrent
+        {
+            /**
+             * Lock-free stack of the free indices of a fixed pool, any thread may push and pop.
+             * The head carries a tag bumped on every change so a popped and pushed back index
+             * cannot pass for the old head (no ABA).
+             **/
+            class FreeList
+            {
+                private:
+                    static constexpr uint32_t end = UINT32_MAX;
+
+                    std::atomic<uint32_t>* _next = nullptr;
+                    char _padding0[64];
+                    std::atomic<uint64_t> _head{ end };
+                    char _padding1[64];
+
+                    static uint64_t Pack(uint64_t head, uint32_t index)
+                    {
+                        return (((head >> 32) + 1) << 32) | index;
+                    }
+
+                public:
+                    FreeList(std::size_t capacity)
+                    {
+                        if (capacity >= end)
+                        {
+                            throw std::exception();
+                        }
+
+                        this->_next = (std::atomic<uint32_t>*)malloc((capacity == 0 ? 1 : capacity) * sizeof(std::atomic<uint32_t>));
+                        if (this->_next == nullptr)
+                        {
+                            throw std::exception();
+                        }
+
+                        for (std::size_t i = 0; i < capacity; i++)
+                        {
+                            new (&(this->_next[i])) std::atomic<uint32_t>((i + 1 < capacity) ? (uint32_t)(i + 1) : end);
+                        }
+                        this->_head.store(capacity == 0 ? end : 0, std::memory_order_relaxed);
+                    }
+                    FreeList(const FreeList&) = delete;
+
+                    void Push(uint32_t index)
+                    {
+                        uint64_t head = this->_head.load(std::memory_order_relaxed);
+                        do
+                        {
+                            this->_next[index].store((uint32_t)head, std::memory_order_relaxed);
+                        } while (!this->_head.compare_exchange_weak(head, Pack(head, index), std::memory_order_release, std::memory_order_relaxed));
+                    }
+                    bool TryPop(uint32_t& index)
+                    {
+                        uint64_t head = this->_head.load(std::memory_order_acquire);
+                        while ((uint32_t)head != end)
+                        {
+                            uint32_t next = this->_next[(uint32_t)head].load(std::memory_order_relaxed);
+                            if (this->_head.compare_exchange_weak(head, Pack(head, next), std::memory_order_acquire, std::memory_order_acquire))
+                            {
+                                index = (uint32_t)head;
+                                return true;
+                            }
+                        }
+
+                        return false;
+                    }
+                    bool Empty() const
+                    {
+                        return (uint32_t)(this->_head.load(std::memory_order_relaxed)) == end;
+                    }
+
+                    FreeList& operator=(const FreeList&) = delete;
+
+                    ~FreeList()
+                    {
+                        if (this->_next != nullptr)
+                        {
+                            free((void*)(this->_next));
+                        }
+                        this->_next = nullptr;
+                    }
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__CONCURRENT__MPMCRING__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__CONCURRENT__MPMCRING__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <new>
+
+#include <SPIN/Log/LogRecord.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Concurrent
+        {
+            /**
+             * Bounded ring of fixed size slots. Any number of threads may claim and publish slots,
+             * each slot carries its own sequence number so producers never take a lock. Consuming is
+             * claimed the same way and is just as safe from several threads, a producer may retire
+             * the oldest slot to make room while the worker consumes.
+             **/
+            template<std::size_t slotSize, std::size_t depth>
+            class MPMCRing
+            {
+                static_assert(depth >= 2 && (depth & (depth - 1)) == 0, "MPMCRing depth must be a power of two");
+
+                public:
+                    struct Slot
+                    {
+                        std::atomic<std::size_t> sequence;
+                        std::size_t position;
+                        SPIN::Log::LogRecord record;
+                        char data[slotSize];
+                    };
+
+                private:
+                    Slot* _slots = nullptr;
+                    char _padding0[64];
+                    std::atomic<std::size_t> _enqueuePosition{ 0 };
+                    char _padding1[64];
+                    std::atomic<std::size_t> _dequeuePosition{ 0 };
+                    char _padding2[64];
+
+                    void Allocate()
+                    {
+                        this->_slots = (Slot*)malloc(depth * sizeof(Slot));
+                        if (this->_slots == nullptr)
+                        {
+                            throw std::exception();
+                        }
+
+                        for (std::size_t i = 0; i < depth; i++)
+                        {
+                            new (&(this->_slots[i].sequence)) std::atomic<std::size_t>(i);
+                        }
+                    }
+
+                public:
+                    MPMCRing()
+                    {
+                        this->Allocate();
+                    }
+                    MPMCRing(const MPMCRing&) = delete;
+                    MPMCRing(MPMCRing&& deadObj) noexcept
+                    {
+                        this->_slots = deadObj._slots;
+                        this->_enqueuePosition.store(deadObj._enqueuePosition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                        this->_dequeuePosition.store(deadObj._dequeuePosition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+                        deadObj._slots = nullptr;
+                    }
+
+                    Slot* TryClaim()
+                    {
+                        std::size_t position = this->_enqueuePosition.load(std::memory_order_relaxed);
+                        for (;;)
+                        {
+                            Slot* slot = &(this->_slots[position & (depth - 1)]);
+                            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+                            if (difference == 0)
+                            {
+                                if (this->_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                                {
+                                    slot->position = position;
+                                    return slot;
+                                }
+                            }
+                            else if (difference < 0)
+                            {
+                                return nullptr;
+                            }
+                            else
+                            {
+                                position = this->_enqueuePosition.load(std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                    void Publish(Slot* slot)
+                    {
+                        slot->sequence.store(slot->position + 1, std::memory_order_release);
+                    }
+
+                    Slot* TryConsume()
+                    {
+                        std::size_t position = this->_dequeuePosition.load(std::memory_order_relaxed);
+                        for (;;)
+                        {
+                            Slot* slot = &(this->_slots[position & (depth - 1)]);
+                            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                            intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+                            if (difference == 0)
+                            {
+                                if (this->_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                                {
+                                    slot->position = position;
+                                    return slot;
+                                }
+                            }
+                            else if (difference < 0)
+                            {
+                                return nullptr;
+                            }
+                            else
+                            {
+                                position = this->_dequeuePosition.load(std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                    void Release(Slot* slot)
+                    {
+                        slot->sequence.store(slot->position + depth, std::memory_order_release);
+                    }
+
+                    std::size_t Size() const
+                    {
+                        std::size_t dequeued = this->_dequeuePosition.load(std::memory_order_relaxed);
+                        std::size_t enqueued = this->_enqueuePosition.load(std::memory_order_relaxed);
+
+                        return (enqueued > dequeued) ? enqueued - dequeued : 0;
+                    }
+                    std::size_t EnqueuedCount() const
+                    {
+                        return this->_enqueuePosition.load(std::memory_order_acquire);
+                    }
+
+                    MPMCRing& operator=(const MPMCRing&) = delete;
+                    MPMCRing& operator=(MPMCRing&&) = delete;
+
+                    ~MPMCRing()
+                    {
+                        if (this->_slots != nullptr)
+                        {
+                            free((void*)(this->_slots));
+                        }
+                        this->_slots = nullptr;
+                    }
+            };
+        }
+    }
+}
+
+#endif
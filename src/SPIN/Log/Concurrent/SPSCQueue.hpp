@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__CONCURRENT__SPSCQUEUE__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__CONCURRENT__SPSCQUEUE__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Concurrent
+        {
+            /**
+             * Bounded single producer, single consumer queue of trivially copyable values. Each side
+             * only writes its own index, so neither ever waits on the other.
+             **/
+            template<typename T, std::size_t depth>
+            class SPSCQueue
+            {
+                static_assert(depth >= 1 && (depth & (depth - 1)) == 0, "SPSCQueue depth must be a power of two");
+
+                private:
+                    T* _entries = nullptr;
+                    char _padding0[64];
+                    std::atomic<std::size_t> _head{ 0 };
+                    char _padding1[64];
+                    std::atomic<std::size_t> _tail{ 0 };
+                    char _padding2[64];
+
+                public:
+                    SPSCQueue()
+                    {
+                        this->_entries = (T*)malloc(depth * sizeof(T));
+                        if (this->_entries == nullptr)
+                        {
+                            throw std::exception();
+                        }
+                    }
+                    SPSCQueue(const SPSCQueue&) = delete;
+
+                    bool TryPush(const T& value)
+                    {
+                        std::size_t tail = this->_tail.load(std::memory_order_relaxed);
+                        if (tail - this->_head.load(std::memory_order_acquire) == depth)
+                        {
+                            return false;
+                        }
+
+                        this->_entries[tail & (depth - 1)] = value;
+                        this->_tail.store(tail + 1, std::memory_order_release);
+
+                        return true;
+                    }
+                    bool TryPop(T& value)
+                    {
+                        std::size_t head = this->_head.load(std::memory_order_relaxed);
+                        if (head == this->_tail.load(std::memory_order_acquire))
+                        {
+                            return false;
+                        }
+
+                        value = this->_entries[head & (depth - 1)];
+                        this->_head.store(head + 1, std::memory_order_release);
+
+                        return true;
+                    }
+
+                    std::size_t Size() const
+                    {
+                        std::size_t head = this->_head.load(std::memory_order_relaxed);
+                        std::size_t tail = this->_tail.load(std::memory_order_relaxed);
+
+                        return (tail > head) ? tail - head : 0;
+                    }
+
+                    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+                    ~SPSCQueue()
+                    {
+                        if (this->_entries != nullptr)
+                        {
+                            free((void*)(this->_entries));
+                        }
+                        this->_entries = nullptr;
+                    }
+            };
+        }
+    }
+}
+
+#endif
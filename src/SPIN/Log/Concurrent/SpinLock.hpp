@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__CONCURRENT__SPINLOCK__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__CONCURRENT__SPINLOCK__H__
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Concurrent
+        {
+            /**
+             * Test-and-test-and-set lock that yields after a short spin and counts how often
+             * it was found taken. Copies start unlocked with fresh counters.
+             **/
+            class SpinLock
+            {
+                private:
+                    std::atomic<bool> _locked{ false };
+                    std::atomic<uint64_t> _contentions{ 0 };
+
+                public:
+                    SpinLock() = default;
+                    SpinLock(const SpinLock&)
+                    {
+                    }
+
+                    void Lock()
+                    {
+                        if (!this->_locked.exchange(true, std::memory_order_acquire))
+                        {
+                            return;
+                        }
+
+                        this->_contentions.fetch_add(1, std::memory_order_relaxed);
+                        for (uint32_t spins = 0;; spins++)
+                        {
+                            if (!this->_locked.load(std::memory_order_relaxed)
+                                && !this->_locked.exchange(true, std::memory_order_acquire))
+                            {
+                                return;
+                            }
+
+                            if (spins >= 64)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+                    void Unlock()
+                    {
+                        this->_locked.store(false, std::memory_order_release);
+                    }
+
+                    uint64_t GetContentionCount() const
+                    {
+                        return this->_contentions.load(std::memory_order_relaxed);
+                    }
+
+                    SpinLock& operator=(const SpinLock&)
+                    {
+                        return *this;
+                    }
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FLUSHPOLICY__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FLUSHPOLICY__H__
+
+#include <stdint.h>
+
+#include <SPIN/Log/LogLevel.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        /**
+         * When a sink flushes on its own. Every trigger starts off and any mix can be set, the
+         * first one met flushes and restarts the counts of all of them.
+         **/
+        struct FlushPolicy
+        {
+            // Flush right after a record at or above level.
+            bool onLevel = false;
+            SPIN::Log::LogLevel level = SPIN::Log::LogLevel::Error;
+            // Flush once this many records or bytes were handled since the last flush, 0 is off.
+            uint32_t records = 0;
+            uint32_t bytes = 0;
+            // Flush once this many microseconds passed since the last flush, needs a FlushTimer.
+            uint64_t interval = 0;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/FlushTimer.hpp>
+
+#ifndef ARDUINO
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+#include <SPIN/Log/Clock.hpp>
+
+
+namespace
+{
+    // Upper bound on a sleep, so a timer watching no due sink still notices Stop.
+    const uint64_t maximumSleep = 1000000;
+}
+
+
+
+SPIN::Log::FlushTimer::FlushTimer(SPIN::Log::Sinks::ISink** sinks, std::size_t numberOfSinks, uint64_t resolution)
+{
+    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc((numberOfSinks == 0 ? 1 : numberOfSinks) * sizeof(SPIN::Log::Sinks::ISink*));
+    if (this->_sinks == nullptr)
+    {
+        throw std::exception();
+    }
+    memcpy((void*)(this->_sinks), (const void*)sinks, numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+    this->_numberOfSinks = numberOfSinks;
+    this->_resolution = resolution;
+}
+SPIN::Log::FlushTimer::FlushTimer(SPIN::Log::FlushTimer&& deadObj) noexcept
+{
+    this->_sinks = deadObj._sinks;
+    this->_numberOfSinks = deadObj._numberOfSinks;
+    this->_resolution = deadObj._resolution;
+
+    deadObj._sinks = nullptr;
+    deadObj._numberOfSinks = 0;
+}
+
+
+void SPIN::Log::FlushTimer::Run()
+{
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    while (this->_running.load(std::memory_order_acquire))
+    {
+        this->_wakeUps++;
+        lock.unlock();
+
+        uint64_t now = SPIN::Log::Clock::Microseconds();
+        uint64_t next = now + maximumSleep;
+        for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+        {
+            uint64_t due = this->_sinks[i]->FlushIfDue(now, this->_resolution);
+            next = (due < next) ? due : next;
+        }
+
+        lock.lock();
+        if (this->_running.load(std::memory_order_relaxed))
+        {
+            this->_wakeUp.wait_for(lock, std::chrono::microseconds(next > now ? next - now : 0));
+        }
+    }
+}
+
+void SPIN::Log::FlushTimer::Start()
+{
+    if (this->_running.exchange(true))
+    {
+        return;
+    }
+
+    this->_worker = std::thread(&SPIN::Log::FlushTimer::Run, this);
+}
+void SPIN::Log::FlushTimer::Stop()
+{
+    if (!this->_running.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_wakeUp.notify_one();
+    }
+    this->_worker.join();
+}
+
+uint64_t SPIN::Log::FlushTimer::GetWakeUpCount()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_wakeUps;
+}
+
+
+SPIN::Log::FlushTimer::~FlushTimer()
+{
+    this->Stop();
+
+    if (this->_sinks != nullptr)
+    {
+        free((void*)(this->_sinks));
+    }
+    this->_sinks = nullptr;
+    this->_numberOfSinks = 0;
+}
+
+
+
+bool SPIN::Log::Factory::FlushTimerFactory::DoubleCapacityIfNeeded()
+{
+    if (this->_sinks == nullptr)
+    {
+        this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(2 * sizeof(SPIN::Log::Sinks::ISink*));
+        if (this->_sinks == nullptr)
+        {
+            return false;
+        }
+        this->_sizeOfSinks = 2;
+    }
+
+    if (this->_numberOfSinks < this->_sizeOfSinks)
+    {
+        return true;
+    }
+
+    auto** temp = (SPIN::Log::Sinks::ISink**)realloc(this->_sinks, this->_sizeOfSinks * 2 * sizeof(SPIN::Log::Sinks::ISink*));
+    if (temp == nullptr)
+    {
+        return false;
+    }
+
+    this->_sinks = temp;
+    this->_sizeOfSinks *= 2;
+
+    return true;
+}
+
+
+SPIN::Log::Factory::FlushTimerFactory::FlushTimerFactory(const SPIN::Log::Factory::FlushTimerFactory& obj)
+{
+    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc((obj._sizeOfSinks == 0 ? 1 : obj._sizeOfSinks) * sizeof(SPIN::Log::Sinks::ISink*));
+    if (this->_sinks == nullptr)
+    {
+        throw std::exception();
+    }
+    this->_numberOfSinks = obj._numberOfSinks;
+    this->_sizeOfSinks = obj._sizeOfSinks;
+    this->_resolution = obj._resolution;
+
+    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+}
+SPIN::Log::Factory::FlushTimerFactory::FlushTimerFactory(SPIN::Log::Factory::FlushTimerFactory&& deadObj) noexcept
+{
+    this->_sinks = deadObj._sinks;
+    this->_numberOfSinks = deadObj._numberOfSinks;
+    this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_resolution = deadObj._resolution;
+
+    deadObj._sinks = nullptr;
+    deadObj._numberOfSinks = 0;
+    deadObj._sizeOfSinks = 0;
+}
+
+
+SPIN::Log::Factory::FlushTimerFactory& SPIN::Log::Factory::FlushTimerFactory::AddSink(SPIN::Log::Sinks::ISink* sink)
+{
+    if (!this->DoubleCapacityIfNeeded())
+    {
+        throw std::exception();
+    }
+
+    this->_sinks[this->_numberOfSinks++] = sink;
+
+    return *this;
+}
+SPIN::Log::Factory::FlushTimerFactory& SPIN::Log::Factory::FlushTimerFactory::SetResolution(uint64_t resolution)
+{
+    this->_resolution = resolution;
+
+    return *this;
+}
+
+
+SPIN::Log::FlushTimer SPIN::Log::Factory::FlushTimerFactory::Build()
+{
+    return SPIN::Log::FlushTimer(this->_sinks, this->_numberOfSinks, this->_resolution);
+}
+
+
+SPIN::Log::Factory::FlushTimerFactory& SPIN::Log::Factory::FlushTimerFactory::operator=(const SPIN::Log::Factory::FlushTimerFactory& obj)
+{
+    if (this == &obj)
+    {
+        return *this;
+    }
+
+    auto** sinks = (SPIN::Log::Sinks::ISink**)malloc((obj._sizeOfSinks == 0 ? 1 : obj._sizeOfSinks) * sizeof(SPIN::Log::Sinks::ISink*));
+    if (sinks == nullptr)
+    {
+        throw std::exception();
+    }
+    free((void*)(this->_sinks));
+
+    this->_sinks = sinks;
+    this->_numberOfSinks = obj._numberOfSinks;
+    this->_sizeOfSinks = obj._sizeOfSinks;
+    this->_resolution = obj._resolution;
+
+    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+
+    return *this;
+}
+SPIN::Log::Factory::FlushTimerFactory& SPIN::Log::Factory::FlushTimerFactory::operator=(SPIN::Log::Factory::FlushTimerFactory&& deadObj) noexcept
+{
+    free((void*)(this->_sinks));
+
+    this->_sinks = deadObj._sinks;
+    this->_numberOfSinks = deadObj._numberOfSinks;
+    this->_sizeOfSinks = deadObj._sizeOfSinks;
+    this->_resolution = deadObj._resolution;
+
+    deadObj._sinks = nullptr;
+    deadObj._numberOfSinks = 0;
+    deadObj._sizeOfSinks = 0;
+
+    return *this;
+}
+
+
+SPIN::Log::Factory::FlushTimerFactory::~FlushTimerFactory()
+{
+    if (this->_sinks != nullptr)
+    {
+        free((void*)(this->_sinks));
+    }
+
+    this->_sinks = nullptr;
+    this->_numberOfSinks = 0;
+    this->_sizeOfSinks = 0;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FLUSHTIMER__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__FLUSHTIMER__H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <SPIN/Log/Sinks/ISink.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Factory
+        {
+            class FlushTimerFactory;
+        }
+
+        /**
+         * One thread that flushes every watched sink whose FlushPolicy interval ran out. It
+         * sleeps until the earliest sink is due and flushes all sinks due within the same
+         * resolution tick on that wake up. A sink with an interval takes its flush lock around
+         * each delivery, so any logger may keep writing to it.
+         **/
+        class FlushTimer
+        {
+            private:
+                SPIN::Log::Sinks::ISink** _sinks = nullptr;
+                std::size_t _numberOfSinks = 0;
+                uint64_t _resolution = 0;
+                std::thread _worker;
+                std::atomic<bool> _running{ false };
+                std::mutex _mutex;
+                std::condition_variable _wakeUp;
+                uint64_t _wakeUps = 0;
+
+                FlushTimer(SPIN::Log::Sinks::ISink**, std::size_t, uint64_t);
+
+                void Run();
+
+                friend class SPIN::Log::Factory::FlushTimerFactory;
+
+            public:
+                FlushTimer() = delete;
+                FlushTimer(const FlushTimer&) = delete;
+                /** Only valid before Start. **/
+                FlushTimer(FlushTimer&&) noexcept;
+
+                void Start();
+                void Stop();
+
+                /** Number of times the thread woke up to check the sinks. **/
+                uint64_t GetWakeUpCount();
+
+                FlushTimer& operator=(const FlushTimer&) = delete;
+                FlushTimer& operator=(FlushTimer&&) = delete;
+
+                ~FlushTimer();
+        };
+
+        namespace Factory
+        {
+            class FlushTimerFactory
+            {
+                private:
+                    SPIN::Log::Sinks::ISink** _sinks = nullptr;
+                    std::size_t _numberOfSinks = 0;
+                    std::size_t _sizeOfSinks = 0;
+                    uint64_t _resolution = 10000;
+
+                    bool DoubleCapacityIfNeeded();
+                public:
+                    FlushTimerFactory() = default;
+                    FlushTimerFactory(const FlushTimerFactory&);
+                    FlushTimerFactory(FlushTimerFactory&&) noexcept;
+
+                    /** The sink is watched from Build on, add it before it is logged to. **/
+                    FlushTimerFactory& AddSink(SPIN::Log::Sinks::ISink*);
+                    /** Microseconds a flush may come early to share a wake up with another sink. **/
+                    FlushTimerFactory& SetResolution(uint64_t);
+
+                    SPIN::Log::FlushTimer Build();
+
+                    FlushTimerFactory& operator=(const FlushTimerFactory&);
+                    FlushTimerFactory& operator=(FlushTimerFactory&&) noexcept;
+
+                    ~FlushTimerFactory();
+            };
+        }
+    }
+}
+
+#endif
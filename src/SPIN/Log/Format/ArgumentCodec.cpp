@@ -0,0 +1,835 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Format/ArgumentCodec.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
+#include <SPIN/Log/Format/Varint.hpp>
+
+#ifdef ARDUINO
+    #include <stdio.h>
+    #include <string.h>
+#else
+    #include <cstdio>
+    #include <cstring>
+#endif
+
+
+namespace
+{
+    enum class LengthModifier : uint8_t
+    {
+        None,
+        Char,
+        Short,
+        Long,
+        LongLong,
+        IntMax,
+        Size,
+        PtrDiff,
+        LongDouble
+    };
+
+    SPIN::Log::Format::ArgumentType IntegerType(LengthModifier length)
+    {
+        switch (length)
+        {
+            case LengthModifier::Long:
+                return SPIN::Log::Format::ArgumentType::Long;
+            case LengthModifier::LongLong:
+                return SPIN::Log::Format::ArgumentType::LongLong;
+            case LengthModifier::IntMax:
+                return SPIN::Log::Format::ArgumentType::IntMax;
+            case LengthModifier::Size:
+                return SPIN::Log::Format::ArgumentType::Size;
+            case LengthModifier::PtrDiff:
+                return SPIN::Log::Format::ArgumentType::PtrDiff;
+            default:
+                return SPIN::Log::Format::ArgumentType::Int;
+        }
+    }
+
+    template<typename T>
+    bool Store(uint8_t* out, std::size_t capacity, std::size_t& position, T value)
+    {
+        if (position + sizeof(T) > capacity)
+        {
+            return false;
+        }
+
+        memcpy((void*)(out + position), (const void*)&value, sizeof(T));
+        position += sizeof(T);
+
+        return true;
+    }
+
+    template<typename T>
+    bool Load(const uint8_t* in, std::size_t length, std::size_t& position, T& value)
+    {
+        if (position + sizeof(T) > length)
+        {
+            return false;
+        }
+
+        memcpy((void*)&value, (const void*)(in + position), sizeof(T));
+        position += sizeof(T);
+
+        return true;
+    }
+
+    bool PutVarint(uint8_t* out, std::size_t capacity, std::size_t& position, uint64_t value)
+    {
+        if (position + SPIN::Log::Format::MaximumVarintSize > capacity)
+        {
+            return false;
+        }
+
+        position += SPIN::Log::Format::WriteVarint(value, out + position);
+
+        return true;
+    }
+    bool PutDouble(uint8_t* out, std::size_t capacity, std::size_t& position, double value)
+    {
+        if (position + 8 > capacity)
+        {
+            return false;
+        }
+
+        uint64_t bits;
+        memcpy((void*)&bits, (const void*)&value, sizeof(bits));
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            out[position++] = (uint8_t)(bits >> (8 * i));
+        }
+
+        return true;
+    }
+    bool GetDouble(const uint8_t* in, std::size_t length, std::size_t& position, double& value)
+    {
+        if (position + 8 > length)
+        {
+            return false;
+        }
+
+        uint64_t bits = 0;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            bits |= (uint64_t)in[position++] << (8 * i);
+        }
+        memcpy((void*)&value, (const void*)&bits, sizeof(bits));
+
+        return true;
+    }
+
+    template<typename T>
+    bool EncodeInteger(const uint8_t* in, std::size_t length, std::size_t& position, bool isSigned, uint8_t* out, std::size_t capacity, std::size_t& written)
+    {
+        T value;
+        if (!Load<T>(in, length, position, value))
+        {
+            return false;
+        }
+
+        uint64_t encoded = isSigned ? SPIN::Log::Format::ZigZagEncode((int64_t)value) : (uint64_t)value;
+        if (!isSigned && sizeof(T) < sizeof(uint64_t))
+        {
+            encoded &= ~(uint64_t)0 >> (64 - 8 * sizeof(T));
+        }
+
+        return PutVarint(out, capacity, written, encoded);
+    }
+    template<typename T>
+    bool DecodeInteger(const uint8_t* in, std::size_t length, std::size_t& position, bool isSigned, uint8_t* out, std::size_t capacity, std::size_t& written)
+    {
+        uint64_t encoded;
+        if (!SPIN::Log::Format::ReadVarint(in, length, position, encoded))
+        {
+            return false;
+        }
+
+        T value = isSigned ? (T)SPIN::Log::Format::ZigZagDecode(encoded) : (T)encoded;
+
+        return Store<T>(out, capacity, written, value);
+    }
+
+    // Steps over a captured argument that is not rendered, together with its star arguments.
+    bool SkipArgument(const uint8_t* in, std::size_t length, std::size_t& position, const SPIN::Log::Format::Specification& spec)
+    {
+        std::size_t size = spec.starArguments * sizeof(int);
+        switch (spec.type)
+        {
+            case SPIN::Log::Format::ArgumentType::None:
+                break;
+            case SPIN::Log::Format::ArgumentType::Int:
+                size += sizeof(int);
+                break;
+            case SPIN::Log::Format::ArgumentType::Long:
+                size += sizeof(long);
+                break;
+            case SPIN::Log::Format::ArgumentType::LongLong:
+                size += sizeof(long long);
+                break;
+            case SPIN::Log::Format::ArgumentType::IntMax:
+                size += sizeof(intmax_t);
+                break;
+            case SPIN::Log::Format::ArgumentType::Size:
+                size += sizeof(std::size_t);
+                break;
+            case SPIN::Log::Format::ArgumentType::PtrDiff:
+                size += sizeof(ptrdiff_t);
+                break;
+            case SPIN::Log::Format::ArgumentType::Double:
+                size += sizeof(double);
+                break;
+            case SPIN::Log::Format::ArgumentType::LongDouble:
+                size += sizeof(long double);
+                break;
+            case SPIN::Log::Format::ArgumentType::Pointer:
+                size += sizeof(const void*);
+                break;
+            case SPIN::Log::Format::ArgumentType::String:
+            {
+                std::size_t lengthAt = position + size;
+                uint16_t stringLength;
+                if (!Load<uint16_t>(in, length, lengthAt, stringLength))
+                {
+                    return false;
+                }
+                size += sizeof(uint16_t) + stringLength + 1;
+                break;
+            }
+        }
+
+        if (position + size > length)
+        {
+            return false;
+        }
+        position += size;
+
+        return true;
+    }
+
+    template<typename T>
+    int RenderOne(char* out, std::size_t capacity, const char* spec, uint8_t starArguments, const int* stars, T value)
+    {
+        // The library renderer knows every flag but grouping, which only snprintf can honour.
+        if (strchr(spec, '\'') == nullptr)
+        {
+            SPIN::Log::Format::Argument arguments[3];
+            for (uint8_t i = 0; i < starArguments; i++)
+            {
+                arguments[i] = SPIN::Log::Format::MakeArgument(stars[i]);
+            }
+            arguments[starArguments] = SPIN::Log::Format::MakeArgument(value);
+
+            return (int)SPIN::Log::Format::FormatArguments(out, capacity, spec, arguments, (std::size_t)starArguments + 1);
+        }
+
+        switch (starArguments)
+        {
+            case 0:
+                return snprintf(out, capacity, spec, value);
+            case 1:
+                return snprintf(out, capacity, spec, stars[0], value);
+            default:
+                return snprintf(out, capacity, spec, stars[0], stars[1], value);
+        }
+    }
+}
+
+
+const char* SPIN::Log::Format::ParseSpecification(const char* percent, SPIN::Log::Format::Specification& spec)
+{
+    const char* cursor = percent + 1;
+
+    spec.text = percent;
+    spec.starArguments = 0;
+    spec.isSigned = false;
+    spec.conversion = '\0';
+    spec.type = SPIN::Log::Format::ArgumentType::None;
+
+    if (*cursor == '%')
+    {
+        spec.conversion = '%';
+        spec.length = 2;
+        return cursor + 1;
+    }
+
+    while (*cursor != '\0' && strchr("-+ #0'", *cursor) != nullptr)
+    {
+        cursor++;
+    }
+
+    if (*cursor == '*')
+    {
+        spec.starArguments++;
+        cursor++;
+    }
+    while (*cursor >= '0' && *cursor <= '9')
+    {
+        cursor++;
+    }
+
+    if (*cursor == '.')
+    {
+        cursor++;
+        if (*cursor == '*')
+        {
+            spec.starArguments++;
+            cursor++;
+        }
+        while (*cursor >= '0' && *cursor <= '9')
+        {
+            cursor++;
+        }
+    }
+
+    LengthModifier length = LengthModifier::None;
+    switch (*cursor)
+    {
+        case 'h':
+            cursor++;
+            length = LengthModifier::Short;
+            if (*cursor == 'h')
+            {
+                cursor++;
+                length = LengthModifier::Char;
+            }
+            break;
+        case 'l':
+            cursor++;
+            length = LengthModifier::Long;
+            if (*cursor == 'l')
+            {
+                cursor++;
+                length = LengthModifier::LongLong;
+            }
+            break;
+        case 'j':
+            cursor++;
+            length = LengthModifier::IntMax;
+            break;
+        case 'z':
+            cursor++;
+            length = LengthModifier::Size;
+            break;
+        case 't':
+            cursor++;
+            length = LengthModifier::PtrDiff;
+            break;
+        case 'L':
+            cursor++;
+            length = LengthModifier::LongDouble;
+            break;
+        default:
+            break;
+    }
+
+    spec.conversion = *cursor;
+    switch (*cursor)
+    {
+        case 'd':
+        case 'i':
+            spec.isSigned = true;
+            spec.type = IntegerType(length);
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            spec.type = IntegerType(length);
+            break;
+        case 'c':
+            spec.isSigned = true;
+            spec.type = SPIN::Log::Format::ArgumentType::Int;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec.type = (length == LengthModifier::LongDouble) ? SPIN::Log::Format::ArgumentType::LongDouble : SPIN::Log::Format::ArgumentType::Double;
+            break;
+        case 's':
+            spec.type = (length == LengthModifier::Long) ? SPIN::Log::Format::ArgumentType::Pointer : SPIN::Log::Format::ArgumentType::String;
+            break;
+        case 'p':
+        case 'n':
+            spec.type = SPIN::Log::Format::ArgumentType::Pointer;
+            break;
+        default:
+            spec.conversion = '\0';
+            break;
+    }
+
+    if (*cursor != '\0')
+    {
+        cursor++;
+    }
+    spec.length = (std::size_t)(cursor - percent);
+
+    return cursor;
+}
+
+
+std::size_t SPIN::Log::Format::CaptureArguments(const char* fmt, va_list args, uint8_t* out, std::size_t capacity)
+{
+    std::size_t position = 0;
+    SPIN::Log::Format::Specification spec;
+
+    const char* cursor = fmt;
+    while ((cursor = strchr(cursor, '%')) != nullptr)
+    {
+        cursor = SPIN::Log::Format::ParseSpecification(cursor, spec);
+        if (spec.conversion == 's' && spec.type == SPIN::Log::Format::ArgumentType::Pointer)
+        {
+            return SPIN::Log::Format::Uncapturable;
+        }
+
+        for (uint8_t i = 0; i < spec.starArguments; i++)
+        {
+            if (!Store<int>(out, capacity, position, va_arg(args, int)))
+            {
+                return SPIN::Log::Format::Uncapturable;
+            }
+        }
+
+        bool stored = true;
+        switch (spec.type)
+        {
+            case SPIN::Log::Format::ArgumentType::None:
+                break;
+            case SPIN::Log::Format::ArgumentType::Int:
+                stored = Store<int>(out, capacity, position, va_arg(args, int));
+                break;
+            case SPIN::Log::Format::ArgumentType::Long:
+                stored = Store<long>(out, capacity, position, va_arg(args, long));
+                break;
+            case SPIN::Log::Format::ArgumentType::LongLong:
+                stored = Store<long long>(out, capacity, position, va_arg(args, long long));
+                break;
+            case SPIN::Log::Format::ArgumentType::IntMax:
+                stored = Store<intmax_t>(out, capacity, position, va_arg(args, intmax_t));
+                break;
+            case SPIN::Log::Format::ArgumentType::Size:
+                stored = Store<std::size_t>(out, capacity, position, va_arg(args, std::size_t));
+                break;
+            case SPIN::Log::Format::ArgumentType::PtrDiff:
+                stored = Store<ptrdiff_t>(out, capacity, position, va_arg(args, ptrdiff_t));
+                break;
+            case SPIN::Log::Format::ArgumentType::Double:
+                stored = Store<double>(out, capacity, position, va_arg(args, double));
+                break;
+            case SPIN::Log::Format::ArgumentType::LongDouble:
+                stored = Store<long double>(out, capacity, position, va_arg(args, long double));
+                break;
+            case SPIN::Log::Format::ArgumentType::Pointer:
+                stored = Store<const void*>(out, capacity, position, va_arg(args, const void*));
+                break;
+            case SPIN::Log::Format::ArgumentType::String:
+            {
+                const char* string = va_arg(args, const char*);
+                if (string == nullptr)
+                {
+                    string = "(null)";
+                }
+
+                // A string is kept whole or not at all, a cut one would render as a different record.
+                std::size_t length = strlen(string);
+                if (length > UINT16_MAX || position + sizeof(uint16_t) + length + 1 > capacity)
+                {
+                    return SPIN::Log::Format::Uncapturable;
+                }
+
+                Store<uint16_t>(out, capacity, position, (uint16_t)length);
+                memcpy((void*)(out + position), (const void*)string, length);
+                position += length;
+                out[position++] = '\0';
+                break;
+            }
+        }
+
+        if (!stored)
+        {
+            return SPIN::Log::Format::Uncapturable;
+        }
+    }
+
+    return position;
+}
+
+
+std::size_t SPIN::Log::Format::RenderArguments(const char* fmt, const uint8_t* args, std::size_t length, char* out, std::size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    std::size_t written = 0;
+    std::size_t position = 0;
+    SPIN::Log::Format::Specification spec;
+    char specText[32];
+
+    const char* cursor = fmt;
+    while (*cursor != '\0' && written + 1 < capacity)
+    {
+        const char* percent = strchr(cursor, '%');
+        std::size_t literalLength = (percent == nullptr) ? strlen(cursor) : (std::size_t)(percent - cursor);
+        if (literalLength > capacity - 1 - written)
+        {
+            literalLength = capacity - 1 - written;
+        }
+        memcpy((void*)(out + written), (const void*)cursor, literalLength);
+        written += literalLength;
+
+        if (percent == nullptr || written + 1 >= capacity)
+        {
+            break;
+        }
+
+        cursor = SPIN::Log::Format::ParseSpecification(percent, spec);
+        if (spec.conversion == '%')
+        {
+            out[written++] = '%';
+            continue;
+        }
+        if (spec.conversion == '\0')
+        {
+            continue;
+        }
+        if (spec.conversion == 'n' || spec.length >= sizeof(specText)
+            || (spec.conversion == 's' && spec.type == SPIN::Log::Format::ArgumentType::Pointer))
+        {
+            if (!SkipArgument(args, length, position, spec))
+            {
+                break;
+            }
+            continue;
+        }
+
+        memcpy((void*)specText, (const void*)spec.text, spec.length);
+        specText[spec.length] = '\0';
+
+        int stars[2] = { 0, 0 };
+        for (uint8_t i = 0; i < spec.starArguments; i++)
+        {
+            if (!Load<int>(args, length, position, stars[i]))
+            {
+                out[written] = '\0';
+                return written;
+            }
+        }
+
+        char* target = out + written;
+        std::size_t remaining = capacity - written;
+        int rendered = -1;
+        switch (spec.type)
+        {
+            case SPIN::Log::Format::ArgumentType::Int:
+            {
+                int value;
+                if (Load<int>(args, length, position, value))
+                {
+                    rendered = spec.isSigned ? RenderOne<int>(target, remaining, specText, spec.starArguments, stars, value)
+                                             : RenderOne<unsigned int>(target, remaining, specText, spec.starArguments, stars, (unsigned int)value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Long:
+            {
+                long value;
+                if (Load<long>(args, length, position, value))
+                {
+                    rendered = spec.isSigned ? RenderOne<long>(target, remaining, specText, spec.starArguments, stars, value)
+                                             : RenderOne<unsigned long>(target, remaining, specText, spec.starArguments, stars, (unsigned long)value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::LongLong:
+            {
+                long long value;
+                if (Load<long long>(args, length, position, value))
+                {
+                    rendered = spec.isSigned ? RenderOne<long long>(target, remaining, specText, spec.starArguments, stars, value)
+                                             : RenderOne<unsigned long long>(target, remaining, specText, spec.starArguments, stars, (unsigned long long)value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::IntMax:
+            {
+                intmax_t value;
+                if (Load<intmax_t>(args, length, position, value))
+                {
+                    rendered = spec.isSigned ? RenderOne<intmax_t>(target, remaining, specText, spec.starArguments, stars, value)
+                                             : RenderOne<uintmax_t>(target, remaining, specText, spec.starArguments, stars, (uintmax_t)value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Size:
+            {
+                std::size_t value;
+                if (Load<std::size_t>(args, length, position, value))
+                {
+                    rendered = RenderOne<std::size_t>(target, remaining, specText, spec.starArguments, stars, value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::PtrDiff:
+            {
+                ptrdiff_t value;
+                if (Load<ptrdiff_t>(args, length, position, value))
+                {
+                    rendered = RenderOne<ptrdiff_t>(target, remaining, specText, spec.starArguments, stars, value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Double:
+            {
+                double value;
+                if (Load<double>(args, length, position, value))
+                {
+                    rendered = RenderOne<double>(target, remaining, specText, spec.starArguments, stars, value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::LongDouble:
+            {
+                long double value;
+                if (Load<long double>(args, length, position, value))
+                {
+                    rendered = RenderOne<long double>(target, remaining, specText, spec.starArguments, stars, value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Pointer:
+            {
+                const void* value;
+                if (Load<const void*>(args, length, position, value))
+                {
+                    rendered = RenderOne<const void*>(target, remaining, specText, spec.starArguments, stars, value);
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::String:
+            {
+                uint16_t stringLength;
+                if (Load<uint16_t>(args, length, position, stringLength) && position + stringLength + 1 <= length)
+                {
+                    rendered = RenderOne<const char*>(target, remaining, specText, spec.starArguments, stars, (const char*)(args + position));
+                    position += stringLength + 1;
+                }
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::None:
+                continue;
+        }
+
+        if (rendered < 0)
+        {
+            break;
+        }
+        written += ((std::size_t)rendered < remaining) ? (std::size_t)rendered : remaining - 1;
+    }
+
+    out[written] = '\0';
+
+    return written;
+}
+
+
+
+std::size_t SPIN::Log::Format::EncodeArguments(const char* fmt, const uint8_t* args, std::size_t length, uint8_t* out, std::size_t capacity)
+{
+    std::size_t position = 0;
+    std::size_t written = 0;
+    SPIN::Log::Format::Specification spec;
+
+    const char* cursor = fmt;
+    while ((cursor = strchr(cursor, '%')) != nullptr && position < length)
+    {
+        cursor = SPIN::Log::Format::ParseSpecification(cursor, spec);
+
+        for (uint8_t i = 0; i < spec.starArguments; i++)
+        {
+            if (!EncodeInteger<int>(args, length, position, true, out, capacity, written))
+            {
+                return 0;
+            }
+        }
+
+        bool encoded = true;
+        switch (spec.type)
+        {
+            case SPIN::Log::Format::ArgumentType::None:
+                break;
+            case SPIN::Log::Format::ArgumentType::Int:
+                encoded = EncodeInteger<int>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Long:
+                encoded = EncodeInteger<long>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::LongLong:
+                encoded = EncodeInteger<long long>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::IntMax:
+                encoded = EncodeInteger<intmax_t>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Size:
+                encoded = EncodeInteger<std::size_t>(args, length, position, false, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::PtrDiff:
+                encoded = EncodeInteger<ptrdiff_t>(args, length, position, true, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Double:
+            {
+                double value;
+                encoded = Load<double>(args, length, position, value) && PutDouble(out, capacity, written, value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::LongDouble:
+            {
+                long double value;
+                encoded = Load<long double>(args, length, position, value) && PutDouble(out, capacity, written, (double)value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Pointer:
+            {
+                const void* value;
+                encoded = Load<const void*>(args, length, position, value) && PutVarint(out, capacity, written, (uint64_t)(uintptr_t)value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::String:
+            {
+                uint16_t stringLength;
+                if (!Load<uint16_t>(args, length, position, stringLength) || position + stringLength + 1 > length
+                    || !PutVarint(out, capacity, written, stringLength) || written + stringLength > capacity)
+                {
+                    return 0;
+                }
+
+                memcpy((void*)(out + written), (const void*)(args + position), stringLength);
+                written += stringLength;
+                position += stringLength + 1;
+                break;
+            }
+        }
+
+        if (!encoded)
+        {
+            return 0;
+        }
+    }
+
+    return written;
+}
+std::size_t SPIN::Log::Format::DecodeArguments(const char* fmt, const uint8_t* args, std::size_t length, uint8_t* out, std::size_t capacity)
+{
+    std::size_t position = 0;
+    std::size_t written = 0;
+    SPIN::Log::Format::Specification spec;
+
+    const char* cursor = fmt;
+    while ((cursor = strchr(cursor, '%')) != nullptr && position < length)
+    {
+        cursor = SPIN::Log::Format::ParseSpecification(cursor, spec);
+
+        for (uint8_t i = 0; i < spec.starArguments; i++)
+        {
+            if (!DecodeInteger<int>(args, length, position, true, out, capacity, written))
+            {
+                return 0;
+            }
+        }
+
+        bool decoded = true;
+        switch (spec.type)
+        {
+            case SPIN::Log::Format::ArgumentType::None:
+                break;
+            case SPIN::Log::Format::ArgumentType::Int:
+                decoded = DecodeInteger<int>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Long:
+                decoded = DecodeInteger<long>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::LongLong:
+                decoded = DecodeInteger<long long>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::IntMax:
+                decoded = DecodeInteger<intmax_t>(args, length, position, spec.isSigned, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Size:
+                decoded = DecodeInteger<std::size_t>(args, length, position, false, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::PtrDiff:
+                decoded = DecodeInteger<ptrdiff_t>(args, length, position, true, out, capacity, written);
+                break;
+            case SPIN::Log::Format::ArgumentType::Double:
+            {
+                double value;
+                decoded = GetDouble(args, length, position, value) && Store<double>(out, capacity, written, value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::LongDouble:
+            {
+                double value;
+                decoded = GetDouble(args, length, position, value) && Store<long double>(out, capacity, written, (long double)value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::Pointer:
+            {
+                uint64_t value;
+                decoded = SPIN::Log::Format::ReadVarint(args, length, position, value)
+                          && Store<const void*>(out, capacity, written, (const void*)(uintptr_t)value);
+                break;
+            }
+            case SPIN::Log::Format::ArgumentType::String:
+            {
+                uint64_t stringLength;
+                if (!SPIN::Log::Format::ReadVarint(args, length, position, stringLength) || stringLength > UINT16_MAX
+                    || position + stringLength > length || !Store<uint16_t>(out, capacity, written, (uint16_t)stringLength)
+                    || written + stringLength + 1 > capacity)
+                {
+                    return 0;
+                }
+
+                memcpy((void*)(out + written), (const void*)(args + position), (std::size_t)stringLength);
+                written += (std::size_t)stringLength;
+                out[written++] = '\0';
+                position += (std::size_t)stringLength;
+                break;
+            }
+        }
+
+        if (!decoded)
+        {
+            return 0;
+        }
+    }
+
+    return written;
+}
@@ -0,0 +1,103 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FORMAT__ARGUMENTCODEC__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FORMAT__ARGUMENTCODEC__H__
+
+#ifdef ARDUINO
+    #include <stdarg.h>
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstdarg>
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Format
+        {
+            enum class ArgumentType : uint8_t
+            {
+                None = 0,
+                Int = 1,
+                Long = 2,
+                LongLong = 3,
+                IntMax = 4,
+                Size = 5,
+                PtrDiff = 6,
+                Double = 7,
+                LongDouble = 8,
+                String = 9,
+                Pointer = 10
+            };
+
+            struct Specification
+            {
+                const char* text;
+                std::size_t length;
+                uint8_t starArguments;
+                bool isSigned;
+                char conversion;
+                SPIN::Log::Format::ArgumentType type;
+            };
+
+            /**
+             * Parses the printf conversion starting at the '%' pointed to by the first argument,
+             * returns the first character after it.
+             **/
+            const char* ParseSpecification(const char*, SPIN::Log::Format::Specification&);
+
+            /**
+             * Returned by CaptureArguments when the arguments cannot be captured whole, for %ls or
+             * when they do not fit the buffer.
+             **/
+            constexpr std::size_t Uncapturable = (std::size_t)-1;
+
+            /**
+             * Copies the raw values of the arguments described by the format into a buffer,
+             * strings are copied, everything else is stored in its promoted native type. Nothing
+             * is ever cut short, on Uncapturable the caller formats eagerly from its own va_list copy.
+             **/
+            std::size_t CaptureArguments(const char*, va_list, uint8_t*, std::size_t);
+
+            /**
+             * Produces the same text vsnprintf would have produced from the captured arguments.
+             **/
+            std::size_t RenderArguments(const char*, const uint8_t*, std::size_t, char*, std::size_t);
+
+            /**
+             * Converts captured arguments to the portable file form (varint integers, little endian
+             * doubles, length prefixed strings) and back. Both return 0 when the output does not fit.
+             **/
+            std::size_t EncodeArguments(const char*, const uint8_t*, std::size_t, uint8_t*, std::size_t);
+            std::size_t DecodeArguments(const char*, const uint8_t*, std::size_t, uint8_t*, std::size_t);
+        }
+    }
+}
+
+#endif
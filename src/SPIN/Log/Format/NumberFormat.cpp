@@ -0,0 +1,538 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+
+#include <SPIN/Log/Format/NumberFormat.hpp>
+
+#ifdef ARDUINO
+    #include <string.h>
+#else
+    #include <cstring>
+#endif
+
+
+namespace
+{
+    const char digitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    const uint64_t powersOfTen[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+        10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+    };
+
+    // Normalized 10^k for k = -348, -340, ..., 340, rounded to 64 bits.
+    struct CachedPower
+    {
+        uint64_t significand;
+        int16_t exponent;
+    };
+    const CachedPower cachedPowers[87] = {
+        { 0xFA8FD5A0081C0288ULL, -1220 }, { 0xBAAEE17FA23EBF76ULL, -1193 }, { 0x8B16FB203055AC76ULL, -1166 },
+        { 0xCF42894A5DCE35EAULL, -1140 }, { 0x9A6BB0AA55653B2DULL, -1113 }, { 0xE61ACF033D1A45DFULL, -1087 },
+        { 0xAB70FE17C79AC6CAULL, -1060 }, { 0xFF77B1FCBEBCDC4FULL, -1034 }, { 0xBE5691EF416BD60CULL, -1007 },
+        { 0x8DD01FAD907FFC3CULL, -980 }, { 0xD3515C2831559A83ULL, -954 }, { 0x9D71AC8FADA6C9B5ULL, -927 },
+        { 0xEA9C227723EE8BCBULL, -901 }, { 0xAECC49914078536DULL, -874 }, { 0x823C12795DB6CE57ULL, -847 },
+        { 0xC21094364DFB5637ULL, -821 }, { 0x9096EA6F3848984FULL, -794 }, { 0xD77485CB25823AC7ULL, -768 },
+        { 0xA086CFCD97BF97F4ULL, -741 }, { 0xEF340A98172AACE5ULL, -715 }, { 0xB23867FB2A35B28EULL, -688 },
+        { 0x84C8D4DFD2C63F3BULL, -661 }, { 0xC5DD44271AD3CDBAULL, -635 }, { 0x936B9FCEBB25C996ULL, -608 },
+        { 0xDBAC6C247D62A584ULL, -582 }, { 0xA3AB66580D5FDAF6ULL, -555 }, { 0xF3E2F893DEC3F126ULL, -529 },
+        { 0xB5B5ADA8AAFF80B8ULL, -502 }, { 0x87625F056C7C4A8BULL, -475 }, { 0xC9BCFF6034C13053ULL, -449 },
+        { 0x964E858C91BA2655ULL, -422 }, { 0xDFF9772470297EBDULL, -396 }, { 0xA6DFBD9FB8E5B88FULL, -369 },
+        { 0xF8A95FCF88747D94ULL, -343 }, { 0xB94470938FA89BCFULL, -316 }, { 0x8A08F0F8BF0F156BULL, -289 },
+        { 0xCDB02555653131B6ULL, -263 }, { 0x993FE2C6D07B7FACULL, -236 }, { 0xE45C10C42A2B3B06ULL, -210 },
+        { 0xAA242499697392D3ULL, -183 }, { 0xFD87B5F28300CA0EULL, -157 }, { 0xBCE5086492111AEBULL, -130 },
+        { 0x8CBCCC096F5088CCULL, -103 }, { 0xD1B71758E219652CULL, -77 }, { 0x9C40000000000000ULL, -50 },
+        { 0xE8D4A51000000000ULL, -24 }, { 0xAD78EBC5AC620000ULL, 3 }, { 0x813F3978F8940984ULL, 30 },
+        { 0xC097CE7BC90715B3ULL, 56 }, { 0x8F7E32CE7BEA5C70ULL, 83 }, { 0xD5D238A4ABE98068ULL, 109 },
+        { 0x9F4F2726179A2245ULL, 136 }, { 0xED63A231D4C4FB27ULL, 162 }, { 0xB0DE65388CC8ADA8ULL, 189 },
+        { 0x83C7088E1AAB65DBULL, 216 }, { 0xC45D1DF942711D9AULL, 242 }, { 0x924D692CA61BE758ULL, 269 },
+        { 0xDA01EE641A708DEAULL, 295 }, { 0xA26DA3999AEF774AULL, 322 }, { 0xF209787BB47D6B85ULL, 348 },
+        { 0xB454E4A179DD1877ULL, 375 }, { 0x865B86925B9BC5C2ULL, 402 }, { 0xC83553C5C8965D3DULL, 428 },
+        { 0x952AB45CFA97A0B3ULL, 455 }, { 0xDE469FBD99A05FE3ULL, 481 }, { 0xA59BC234DB398C25ULL, 508 },
+        { 0xF6C69A72A3989F5CULL, 534 }, { 0xB7DCBF5354E9BECEULL, 561 }, { 0x88FCF317F22241E2ULL, 588 },
+        { 0xCC20CE9BD35C78A5ULL, 614 }, { 0x98165AF37B2153DFULL, 641 }, { 0xE2A0B5DC971F303AULL, 667 },
+        { 0xA8D9D1535CE3B396ULL, 694 }, { 0xFB9B7CD9A4A7443CULL, 720 }, { 0xBB764C4CA7A44410ULL, 747 },
+        { 0x8BAB8EEFB6409C1AULL, 774 }, { 0xD01FEF10A657842CULL, 800 }, { 0x9B10A4E5E9913129ULL, 827 },
+        { 0xE7109BFBA19C0C9DULL, 853 }, { 0xAC2820D9623BF429ULL, 880 }, { 0x80444B5E7AA7CF85ULL, 907 },
+        { 0xBF21E44003ACDD2DULL, 933 }, { 0x8E679C2F5E44FF8FULL, 960 }, { 0xD433179D9C8CB841ULL, 986 },
+        { 0x9E19DB92B4E31BA9ULL, 1013 }, { 0xEB96BF6EBADF77D9ULL, 1039 }, { 0xAF87023B9BF0EE6BULL, 1066 }
+    };
+
+    // Layout of double, which is a 32 bit float on AVR.
+    template<std::size_t size> struct Binary;
+    template<> struct Binary<8>
+    {
+        typedef uint64_t Bits;
+        static constexpr int significandSize = 52;
+        static constexpr uint32_t exponentMask = 0x7FF;
+        static constexpr int exponentBias = 0x3FF + 52;
+    };
+    template<> struct Binary<4>
+    {
+        typedef uint32_t Bits;
+        static constexpr int significandSize = 23;
+        static constexpr uint32_t exponentMask = 0xFF;
+        static constexpr int exponentBias = 0x7F + 23;
+    };
+    typedef Binary<sizeof(double)> Double;
+
+    const uint64_t hiddenBit = (uint64_t)1 << Double::significandSize;
+
+    // |value| = mantissa * 2^exponent, false for infinities and NaN.
+    bool Decompose(double value, uint64_t& mantissa, int& exponent)
+    {
+        Double::Bits bits;
+        memcpy((void*)&bits, (const void*)&value, sizeof(bits));
+
+        uint64_t significand = (uint64_t)bits & (hiddenBit - 1);
+        uint32_t biased = (uint32_t)(bits >> Double::significandSize) & Double::exponentMask;
+        if (biased == Double::exponentMask)
+        {
+            return false;
+        }
+
+        if (biased == 0)
+        {
+            mantissa = significand;
+            exponent = 1 - Double::exponentBias;
+        }
+        else
+        {
+            mantissa = significand | hiddenBit;
+            exponent = (int)biased - Double::exponentBias;
+        }
+
+        return true;
+    }
+
+    std::size_t CountDigits(uint64_t value)
+    {
+        std::size_t count = 1;
+        while (count < 20 && value >= powersOfTen[count])
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    struct DiyFp
+    {
+        uint64_t f;
+        int e;
+    };
+
+    DiyFp Multiply(const DiyFp& lhs, const DiyFp& rhs)
+    {
+        const uint64_t mask = 0xFFFFFFFFULL;
+        uint64_t a = lhs.f >> 32;
+        uint64_t b = lhs.f & mask;
+        uint64_t c = rhs.f >> 32;
+        uint64_t d = rhs.f & mask;
+        uint64_t ac = a * c;
+        uint64_t bc = b * c;
+        uint64_t ad = a * d;
+        uint64_t bd = b * d;
+        uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask) + (1ULL << 31);
+
+        DiyFp product = { ac + (ad >> 32) + (bc >> 32) + (middle >> 32), lhs.e + rhs.e + 64 };
+        return product;
+    }
+    DiyFp Normalize(DiyFp value)
+    {
+        while ((value.f & (1ULL << 63)) == 0)
+        {
+            value.f <<= 1;
+            value.e--;
+        }
+
+        return value;
+    }
+
+    DiyFp CachedPowerFor(int exponent, int& decimalExponent)
+    {
+        // k = ceil((-61 - exponent) * log10(2)) + 347, log10(2) as a 32 bit fixed point fraction.
+        int64_t scaled = (int64_t)(-61 - exponent) * 1292913986LL;
+        int k = (scaled >= 0) ? (int)((scaled + 0xFFFFFFFFLL) >> 32) : -(int)((-scaled) >> 32);
+        std::size_t index = (std::size_t)(((k + 347) >> 3) + 1);
+
+        decimalExponent = 348 - (int)(index << 3);
+
+        DiyFp power = { cachedPowers[index].significand, cachedPowers[index].exponent };
+        return power;
+    }
+
+    void RoundWeed(char* digits, std::size_t length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance)
+    {
+        while (rest < distance && delta - rest >= tenKappa
+               && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+        {
+            digits[length - 1]--;
+            rest += tenKappa;
+        }
+    }
+
+    std::size_t GenerateDigits(const DiyFp& value, const DiyFp& upper, uint64_t delta, char* digits, int& decimalExponent)
+    {
+        const int shift = -upper.e;
+        const uint64_t one = 1ULL << shift;
+        const uint64_t distance = upper.f - value.f;
+
+        uint32_t integral = (uint32_t)(upper.f >> shift);
+        uint64_t fractional = upper.f & (one - 1);
+        int kappa = (int)CountDigits(integral);
+        std::size_t length = 0;
+
+        while (kappa > 0)
+        {
+            uint32_t divisor = (uint32_t)(powersOfTen[kappa - 1]);
+            uint32_t digit = integral / divisor;
+            integral %= divisor;
+            if (digit != 0 || length != 0)
+            {
+                digits[length++] = (char)('0' + digit);
+            }
+            kappa--;
+
+            uint64_t rest = ((uint64_t)integral << shift) + fractional;
+            if (rest <= delta)
+            {
+                decimalExponent += kappa;
+                RoundWeed(digits, length, delta, rest, powersOfTen[kappa] << shift, distance);
+                return length;
+            }
+        }
+
+        for (;;)
+        {
+            fractional *= 10;
+            delta *= 10;
+            char digit = (char)(fractional >> shift);
+            if (digit != 0 || length != 0)
+            {
+                digits[length++] = (char)('0' + digit);
+            }
+            fractional &= one - 1;
+            kappa--;
+
+            if (fractional < delta)
+            {
+                decimalExponent += kappa;
+                RoundWeed(digits, length, delta, fractional, one, distance * (-kappa < 20 ? powersOfTen[-kappa] : 0));
+                return length;
+            }
+        }
+    }
+}
+
+
+std::size_t SPIN::Log::Format::FormatDecimal(char* out, uint64_t value)
+{
+    std::size_t count = CountDigits(value);
+    char* cursor = out + count;
+
+    // 64 bit division is a library call on small targets, only use it while it is needed.
+    while (value > 0xFFFFFFFFULL)
+    {
+        std::size_t pair = (std::size_t)(value % 100) * 2;
+        value /= 100;
+        *--cursor = digitPairs[pair + 1];
+        *--cursor = digitPairs[pair];
+    }
+
+    uint32_t small = (uint32_t)value;
+    while (small >= 100)
+    {
+        std::size_t pair = (std::size_t)(small % 100) * 2;
+        small /= 100;
+        *--cursor = digitPairs[pair + 1];
+        *--cursor = digitPairs[pair];
+    }
+    if (small >= 10)
+    {
+        *--cursor = digitPairs[small * 2 + 1];
+        *--cursor = digitPairs[small * 2];
+    }
+    else
+    {
+        *--cursor = (char)('0' + small);
+    }
+
+    return count;
+}
+std::size_t SPIN::Log::Format::FormatHexadecimal(char* out, uint64_t value, bool uppercase)
+{
+    const char* alphabet = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    std::size_t count = 1;
+    while (count < 16 && (value >> (4 * count)) != 0)
+    {
+        count++;
+    }
+
+    for (std::size_t i = count; i > 0; i--)
+    {
+        out[i - 1] = alphabet[value & 0xF];
+        value >>= 4;
+    }
+
+    return count;
+}
+std::size_t SPIN::Log::Format::FormatFixed(char* out, std::size_t capacity, double value, int precision)
+{
+    uint64_t mantissa;
+    int exponent;
+    if (precision < 0 || !Decompose(value, mantissa, exponent))
+    {
+        return 0;
+    }
+
+    // |value| = integer + (high * 2^64 + low) / 2^bits
+    uint64_t integer = 0;
+    uint64_t high = 0;
+    uint64_t low = 0;
+    int bits = 0;
+    if (exponent >= 0)
+    {
+        if (exponent >= 64 || ((mantissa << exponent) >> exponent) != mantissa)
+        {
+            return 0;
+        }
+        integer = mantissa << exponent;
+    }
+    else if (mantissa == 0)
+    {
+    }
+    else if (-exponent <= 124)
+    {
+        bits = -exponent;
+        integer = (bits >= 64) ? 0 : mantissa >> bits;
+        low = (bits >= 64) ? mantissa : mantissa & ((1ULL << bits) - 1);
+    }
+    else if (precision > 20)
+    {
+        return 0;
+    }
+    // Otherwise |value| < 2^-71, which rounds to zero at 20 decimals or less.
+
+    std::size_t integerLength = CountDigits(integer);
+    std::size_t length = integerLength + ((precision > 0) ? 1 + (std::size_t)precision : 0);
+    if (length + 1 > capacity)
+    {
+        return 0;
+    }
+
+    // out[0] is kept free for a carry that adds a leading digit.
+    char* digits = out + 1;
+    SPIN::Log::Format::FormatDecimal(digits, integer);
+    char* cursor = digits + integerLength;
+    if (precision > 0)
+    {
+        *cursor++ = '.';
+    }
+    char* end = digits + length;
+
+    bool roundUp = false;
+    if (bits != 0 && bits <= 60)
+    {
+        const uint64_t mask = (1ULL << bits) - 1;
+        while (cursor != end && low != 0)
+        {
+            low *= 10;
+            *cursor++ = (char)('0' + (low >> bits));
+            low &= mask;
+        }
+
+        const uint64_t half = 1ULL << (bits - 1);
+        roundUp = low > half || (low == half && ((end[-1] - '0') & 1) != 0);
+    }
+    else if (bits != 0)
+    {
+        while (cursor != end && (high | low) != 0)
+        {
+            uint64_t lowLow = (low & 0xFFFFFFFFULL) * 10;
+            uint64_t lowHigh = (low >> 32) * 10 + (lowLow >> 32);
+            low = (lowHigh << 32) | (lowLow & 0xFFFFFFFFULL);
+            high = high * 10 + (lowHigh >> 32);
+
+            uint64_t digit;
+            if (bits >= 64)
+            {
+                digit = high >> (bits - 64);
+                high &= (1ULL << (bits - 64)) - 1;
+            }
+            else
+            {
+                digit = (high << (64 - bits)) | (low >> bits);
+                high = 0;
+                low &= (1ULL << bits) - 1;
+            }
+            *cursor++ = (char)('0' + digit);
+        }
+
+        uint64_t halfHigh = (bits > 64) ? 1ULL << (bits - 65) : 0;
+        uint64_t halfLow = (bits > 64) ? 0 : 1ULL << (bits - 1);
+        bool above = high > halfHigh || (high == halfHigh && low > halfLow);
+        bool tie = high == halfHigh && low == halfLow;
+        roundUp = above || (tie && ((end[-1] - '0') & 1) != 0);
+    }
+    memset((void*)cursor, '0', (std::size_t)(end - cursor));
+
+    if (roundUp)
+    {
+        char* digit = end - 1;
+        while (digit >= digits && (*digit == '9' || *digit == '.'))
+        {
+            if (*digit == '9')
+            {
+                *digit = '0';
+            }
+            digit--;
+        }
+
+        if (digit < digits)
+        {
+            out[0] = '1';
+            return length + 1;
+        }
+        (*digit)++;
+    }
+
+    memmove((void*)out, (const void*)digits, length);
+
+    return length;
+}
+std::size_t SPIN::Log::Format::ShortestDigits(char* digits, double value, int& exponent)
+{
+    uint64_t mantissa;
+    int binaryExponent;
+    exponent = 0;
+    if (!Decompose(value, mantissa, binaryExponent) || mantissa == 0)
+    {
+        digits[0] = '0';
+        return 1;
+    }
+
+    // Boundaries halfway to the neighbouring doubles, the lower one is closer at powers of two.
+    DiyFp upper = { (mantissa << 1) + 1, binaryExponent - 1 };
+    while ((upper.f & (hiddenBit << 1)) == 0)
+    {
+        upper.f <<= 1;
+        upper.e--;
+    }
+    upper.f <<= 64 - Double::significandSize - 2;
+    upper.e -= 64 - Double::significandSize - 2;
+
+    DiyFp lower = (mantissa == hiddenBit) ? DiyFp{ (mantissa << 2) - 1, binaryExponent - 2 } : DiyFp{ (mantissa << 1) - 1, binaryExponent - 1 };
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    DiyFp power = CachedPowerFor(upper.e, exponent);
+    DiyFp scaled = Multiply(Normalize(DiyFp{ mantissa, binaryExponent }), power);
+    DiyFp scaledUpper = Multiply(upper, power);
+    DiyFp scaledLower = Multiply(lower, power);
+    scaledLower.f++;
+    scaledUpper.f--;
+
+    return GenerateDigits(scaled, scaledUpper, scaledUpper.f - scaledLower.f, digits, exponent);
+}
+std::size_t SPIN::Log::Format::FormatShortest(char* out, double value)
+{
+    std::size_t length = 0;
+    if (value != value)
+    {
+        memcpy((void*)out, (const void*)"nan", 3);
+        return 3;
+    }
+    if (value < 0 || (value == 0 && 1 / value < 0))
+    {
+        out[length++] = '-';
+    }
+    if (value - value != value - value)
+    {
+        memcpy((void*)(out + length), (const void*)"inf", 3);
+        return length + 3;
+    }
+
+    char digits[SPIN::Log::Format::ShortestDigitsCapacity];
+    int exponent;
+    std::size_t count = SPIN::Log::Format::ShortestDigits(digits, value, exponent);
+    int scientific = (int)count - 1 + exponent;
+
+    if (scientific < -4 || scientific >= 17)
+    {
+        out[length++] = digits[0];
+        if (count > 1)
+        {
+            out[length++] = '.';
+            memcpy((void*)(out + length), (const void*)(digits + 1), count - 1);
+            length += count - 1;
+        }
+        out[length++] = 'e';
+        out[length++] = (scientific < 0) ? '-' : '+';
+        uint32_t magnitude = (uint32_t)((scientific < 0) ? -scientific : scientific);
+        if (magnitude < 10)
+        {
+            out[length++] = '0';
+        }
+        length += SPIN::Log::Format::FormatDecimal(out + length, magnitude);
+    }
+    else if (scientific < 0)
+    {
+        out[length++] = '0';
+        out[length++] = '.';
+        memset((void*)(out + length), '0', (std::size_t)(-scientific - 1));
+        length += (std::size_t)(-scientific - 1);
+        memcpy((void*)(out + length), (const void*)digits, count);
+        length += count;
+    }
+    else if ((std::size_t)scientific + 1 >= count)
+    {
+        memcpy((void*)(out + length), (const void*)digits, count);
+        length += count;
+        memset((void*)(out + length), '0', (std::size_t)scientific + 1 - count);
+        length += (std::size_t)scientific + 1 - count;
+    }
+    else
+    {
+        memcpy((void*)(out + length), (const void*)digits, (std::size_t)scientific + 1);
+        length += (std::size_t)scientific + 1;
+        out[length++] = '.';
+        memcpy((void*)(out + length), (const void*)(digits + scientific + 1), count - (std::size_t)scientific - 1);
+        length += count - (std::size_t)scientific - 1;
+    }
+
+    return length;
+}
@@ -0,0 +1,80 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FORMAT__NUMBERFORMAT__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FORMAT__NUMBERFORMAT__H__
+
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Format
+        {
+            /**
+             * Number kernels behind the formatter. None of them write a terminator or a sign, the
+             * caller owns signs, padding and flags. Buffer sizes below are the worst cases.
+             **/
+            static constexpr std::size_t DecimalCapacity = 20;
+            static constexpr std::size_t HexadecimalCapacity = 16;
+            static constexpr std::size_t ShortestDigitsCapacity = 18;
+            static constexpr std::size_t ShortestCapacity = 25;
+
+            /**
+             * Decimal digits of value, two at a time from a pair table. Returns the digit count.
+             **/
+            std::size_t FormatDecimal(char*, uint64_t);
+            /**
+             * Hexadecimal digits of value without a prefix. Returns the digit count.
+             **/
+            std::size_t FormatHexadecimal(char*, uint64_t, bool uppercase);
+            /**
+             * Digits of |value| rounded to the given number of decimals exactly like "%.*f", ties
+             * to even. Works on the binary value with integer arithmetic only. Returns 0 when it
+             * cannot (not finite, |value| >= 2^64 or the capacity is too small) so the caller can
+             * fall back to snprintf.
+             **/
+            std::size_t FormatFixed(char*, std::size_t, double, int precision);
+            /**
+             * Shortest digits that read back as |value| (Grisu2), |value| = digits * 10^exponent.
+             * value must be finite. Returns the digit count, zero gives "0".
+             **/
+            std::size_t ShortestDigits(char*, double, int& exponent);
+            /**
+             * Round trip text of value in "%g" style with as many digits as ShortestDigits needs,
+             * "nan" and "inf" included. Returns the length.
+             **/
+            std::size_t FormatShortest(char*, double);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Format/TimestampPrefix.hpp>
+
+#include <SPIN/Log/Clock.hpp>
+
+
+static void WriteDigits(char* out, uint32_t value, std::size_t digits)
+{
+    for (std::size_t i = digits; i > 0; i--)
+    {
+        out[i - 1] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+
+void SPIN::Log::Format::TimestampPrefix::RenderSecond(uint64_t second)
+{
+    // Civil date from days since 1970-01-01, Howard Hinnant's civil_from_days.
+    int64_t days = (int64_t)(second / 86400);
+    uint32_t secondOfDay = (uint32_t)(second % 86400);
+
+    days += 719468;
+    int64_t era = days / 146097;
+    uint32_t dayOfEra = (uint32_t)(days - era * 146097);
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t monthIndex = (5 * dayOfYear + 2) / 153;
+    uint32_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    uint32_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    uint32_t year = (uint32_t)(yearOfEra + era * 400) + (month <= 2 ? 1 : 0);
+
+    WriteDigits(this->_text, year % 10000, 4);
+    this->_text[4] = '-';
+    WriteDigits(this->_text + 5, month, 2);
+    this->_text[7] = '-';
+    WriteDigits(this->_text + 8, day, 2);
+    this->_text[10] = ' ';
+    WriteDigits(this->_text + 11, secondOfDay / 3600, 2);
+    this->_text[13] = ':';
+    WriteDigits(this->_text + 14, secondOfDay / 60 % 60, 2);
+    this->_text[16] = ':';
+    WriteDigits(this->_text + 17, secondOfDay % 60, 2);
+    this->_text[19] = '.';
+    this->_text[26] = ' ';
+    this->_text[27] = '\0';
+
+    this->_second = second;
+}
+const char* SPIN::Log::Format::TimestampPrefix::Render(uint64_t monotonic)
+{
+    uint64_t wall = SPIN::Log::Clock::WallMicroseconds(monotonic);
+    uint64_t second = wall / 1000000;
+
+    if (second != this->_second)
+    {
+        this->RenderSecond(second);
+    }
+    WriteDigits(this->_text + 20, (uint32_t)(wall % 1000000), 6);
+
+    return this->_text;
+}
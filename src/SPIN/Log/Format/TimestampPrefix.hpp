@@ -0,0 +1,64 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FORMAT__TIMESTAMPPREFIX__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FORMAT__TIMESTAMPPREFIX__H__
+
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Format
+        {
+            /**
+             * Renders "YYYY-MM-DD HH:MM:SS.uuuuuu " (UTC) for a monotonic timestamp. The date and
+             * time are only recomputed when the second changes, otherwise just the six sub-second
+             * digits are rewritten. Not thread safe, each sink owns one.
+             **/
+            class TimestampPrefix
+            {
+                private:
+                    uint64_t _second = UINT64_MAX;
+                    char _text[28] = { 0 };
+
+                    void RenderSecond(uint64_t);
+
+                public:
+                    static constexpr std::size_t Length = 27;
+
+                    const char* Render(uint64_t);
+            };
+        }
+    }
+}
+
+#endif
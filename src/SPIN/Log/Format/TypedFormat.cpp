@@ -0,0 +1,799 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Format/TypedFormat.hpp>
+
+#include <SPIN/Log/Format/NumberFormat.hpp>
+
+#ifdef ARDUINO
+    #include <stdarg.h>
+    #include <stddef.h>
+    #include <stdio.h>
+    #include <string.h>
+#else
+    #include <cstdarg>
+    #include <cstddef>
+    #include <cstdio>
+    #include <cstring>
+#endif
+
+
+namespace
+{
+    struct Writer
+    {
+        char* out;
+        std::size_t capacity;
+        std::size_t length;
+        std::size_t required;
+
+        void Put(const char* text, std::size_t count)
+        {
+            this->required += count;
+
+            std::size_t room = this->capacity - 1 - this->length;
+            if (count > room)
+            {
+                count = room;
+            }
+            memcpy((void*)(this->out + this->length), (const void*)text, count);
+            this->length += count;
+        }
+        void Fill(char character, std::size_t count)
+        {
+            this->required += count;
+
+            std::size_t room = this->capacity - 1 - this->length;
+            if (count > room)
+            {
+                count = room;
+            }
+            memset((void*)(this->out + this->length), character, count);
+            this->length += count;
+        }
+    };
+
+    struct Conversion
+    {
+        bool leftAlign;
+        bool plus;
+        bool space;
+        bool alternate;
+        bool zeroPad;
+        int width;
+        int precision;
+        char conversion;
+    };
+
+    int64_t AsInteger(const SPIN::Log::Format::Argument& argument)
+    {
+        switch (argument.kind)
+        {
+            case SPIN::Log::Format::ValueKind::Signed:
+                return argument.integer;
+            case SPIN::Log::Format::ValueKind::Unsigned:
+                return (int64_t)(argument.unsignedInteger);
+            case SPIN::Log::Format::ValueKind::Floating:
+                return (int64_t)(argument.floating);
+            case SPIN::Log::Format::ValueKind::LongFloating:
+                return (int64_t)(*argument.longFloating);
+            default:
+                return (int64_t)(uintptr_t)(argument.pointer);
+        }
+    }
+    uint64_t AsUnsigned(const SPIN::Log::Format::Argument& argument)
+    {
+        if (argument.kind == SPIN::Log::Format::ValueKind::Signed && argument.size < sizeof(uint64_t))
+        {
+            // Same reinterpretation printf applies, -1 as %x is ffffffff for an int.
+            return (uint64_t)(argument.integer) & (~(uint64_t)0 >> (64 - 8 * argument.size));
+        }
+
+        return (uint64_t)AsInteger(argument);
+    }
+
+    void Pad(Writer& writer, const Conversion& conversion, std::size_t length, bool before)
+    {
+        if (conversion.width > 0 && (std::size_t)(conversion.width) > length && conversion.leftAlign != before)
+        {
+            writer.Fill(' ', (std::size_t)(conversion.width) - length);
+        }
+    }
+
+    void WriteInteger(Writer& writer, const Conversion& conversion, uint64_t magnitude, bool negative)
+    {
+        char digits[24];
+        char* cursor = digits;
+        std::size_t count = 0;
+        uint32_t base = (conversion.conversion == 'o') ? 8 : ((conversion.conversion == 'x' || conversion.conversion == 'X') ? 16 : 10);
+
+        // Zero has no digits here, the precision decides whether it prints.
+        if (magnitude == 0)
+        {
+        }
+        else if (base == 10)
+        {
+            count = SPIN::Log::Format::FormatDecimal(digits, magnitude);
+        }
+        else if (base == 16)
+        {
+            count = SPIN::Log::Format::FormatHexadecimal(digits, magnitude, conversion.conversion == 'X');
+        }
+        else
+        {
+            cursor = digits + sizeof(digits);
+            while (magnitude != 0)
+            {
+                *--cursor = (char)('0' + (magnitude & 7));
+                magnitude >>= 3;
+            }
+            count = (std::size_t)(digits + sizeof(digits) - cursor);
+        }
+
+        std::size_t precision = (conversion.precision < 0) ? 1 : (std::size_t)(conversion.precision);
+        if (conversion.alternate && base == 8 && precision <= count)
+        {
+            precision = count + 1;
+        }
+        std::size_t zeros = (precision > count) ? precision - count : 0;
+
+        char prefix[2];
+        std::size_t prefixLength = 0;
+        if (negative)
+        {
+            prefix[prefixLength++] = '-';
+        }
+        else if (conversion.plus && base == 10 && conversion.conversion != 'u')
+        {
+            prefix[prefixLength++] = '+';
+        }
+        else if (conversion.space && base == 10 && conversion.conversion != 'u')
+        {
+            prefix[prefixLength++] = ' ';
+        }
+        else if (conversion.alternate && base == 16 && count != 0)
+        {
+            prefix[prefixLength++] = '0';
+            prefix[prefixLength++] = conversion.conversion;
+        }
+
+        std::size_t length = prefixLength + zeros + count;
+        if (conversion.zeroPad && !conversion.leftAlign && conversion.precision < 0 && conversion.width > 0 && (std::size_t)(conversion.width) > length)
+        {
+            zeros += (std::size_t)(conversion.width) - length;
+            length = (std::size_t)(conversion.width);
+        }
+
+        Pad(writer, conversion, length, true);
+        writer.Put(prefix, prefixLength);
+        writer.Fill('0', zeros);
+        writer.Put(cursor, count);
+        Pad(writer, conversion, length, false);
+    }
+
+    void WriteText(Writer& writer, const Conversion& conversion, const char* text, std::size_t length)
+    {
+        Pad(writer, conversion, length, true);
+        writer.Put(text, length);
+        Pad(writer, conversion, length, false);
+    }
+
+    // Shortest digits only equal the correctly rounded ones up to this many significant digits.
+    const int exactSignificantDigits = (sizeof(double) == 8) ? 15 : 6;
+
+    std::size_t ExponentBody(char* body, double magnitude, char conversion, int precision)
+    {
+        bool general = conversion == 'g' || conversion == 'G';
+        int significant = general ? ((precision == 0) ? 1 : precision) : precision + 1;
+        if (significant > exactSignificantDigits)
+        {
+            return 0;
+        }
+
+        char digits[SPIN::Log::Format::ShortestDigitsCapacity];
+        int exponent;
+        std::size_t count = SPIN::Log::Format::ShortestDigits(digits, magnitude, exponent);
+        while (count > 1 && digits[count - 1] == '0')
+        {
+            count--;
+            exponent++;
+        }
+        if ((int)count > significant)
+        {
+            return 0;
+        }
+
+        int scientific = (int)count - 1 + exponent;
+        std::size_t length = 0;
+        if (general && scientific >= -4 && scientific < significant)
+        {
+            if (scientific < 0)
+            {
+                body[length++] = '0';
+                body[length++] = '.';
+                memset((void*)(body + length), '0', (std::size_t)(-scientific - 1));
+                length += (std::size_t)(-scientific - 1);
+                memcpy((void*)(body + length), (const void*)digits, count);
+                return length + count;
+            }
+
+            std::size_t integral = (std::size_t)scientific + 1;
+            if (integral >= count)
+            {
+                memcpy((void*)body, (const void*)digits, count);
+                memset((void*)(body + count), '0', integral - count);
+                return integral;
+            }
+
+            memcpy((void*)body, (const void*)digits, integral);
+            body[integral] = '.';
+            memcpy((void*)(body + integral + 1), (const void*)(digits + integral), count - integral);
+            return count + 1;
+        }
+
+        std::size_t fraction = general ? count - 1 : (std::size_t)precision;
+        body[length++] = digits[0];
+        if (fraction > 0)
+        {
+            body[length++] = '.';
+            memcpy((void*)(body + length), (const void*)(digits + 1), count - 1);
+            memset((void*)(body + length + count - 1), '0', fraction - (count - 1));
+            length += fraction;
+        }
+        body[length++] = (conversion == 'E' || conversion == 'G') ? 'E' : 'e';
+        body[length++] = (scientific < 0) ? '-' : '+';
+        uint32_t magnitudeExponent = (uint32_t)((scientific < 0) ? -scientific : scientific);
+        if (magnitudeExponent < 10)
+        {
+            body[length++] = '0';
+        }
+        length += SPIN::Log::Format::FormatDecimal(body + length, magnitudeExponent);
+
+        return length;
+    }
+
+    // f, e and g through the number kernels, false when only snprintf gets the digits right.
+    bool WriteFastFloating(Writer& writer, const Conversion& conversion, double value)
+    {
+        if (value != value || value - value != value - value)
+        {
+            return false;
+        }
+
+        bool negative = value < 0 || (value == 0 && 1 / value < 0);
+        double magnitude = negative ? -value : value;
+        int precision = (conversion.precision < 0) ? 6 : conversion.precision;
+
+        char body[96];
+        std::size_t length = 0;
+        switch (conversion.conversion)
+        {
+            case 'f':
+            case 'F':
+                length = SPIN::Log::Format::FormatFixed(body, sizeof(body) - 1, magnitude, precision);
+                if (length != 0 && precision == 0 && conversion.alternate)
+                {
+                    body[length++] = '.';
+                }
+                break;
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                if (!conversion.alternate)
+                {
+                    length = ExponentBody(body, magnitude, conversion.conversion, precision);
+                }
+                break;
+            default:
+                break;
+        }
+        if (length == 0)
+        {
+            return false;
+        }
+
+        char sign = negative ? '-' : (conversion.plus ? '+' : (conversion.space ? ' ' : '\0'));
+        std::size_t total = length + ((sign != '\0') ? 1 : 0);
+        bool zeroPad = conversion.zeroPad && !conversion.leftAlign && conversion.width > 0 && (std::size_t)(conversion.width) > total;
+
+        if (!zeroPad)
+        {
+            Pad(writer, conversion, total, true);
+        }
+        if (sign != '\0')
+        {
+            writer.Put(&sign, 1);
+        }
+        if (zeroPad)
+        {
+            writer.Fill('0', (std::size_t)(conversion.width) - total);
+        }
+        writer.Put(body, length);
+        Pad(writer, conversion, total, false);
+
+        return true;
+    }
+
+    void WriteFloating(Writer& writer, const Conversion& conversion, const SPIN::Log::Format::Argument& argument)
+    {
+        if (argument.kind != SPIN::Log::Format::ValueKind::LongFloating
+            && WriteFastFloating(writer, conversion, (argument.kind == SPIN::Log::Format::ValueKind::Floating) ? argument.floating : (double)AsInteger(argument)))
+        {
+            return;
+        }
+
+        char spec[32];
+        std::size_t position = 0;
+
+        spec[position++] = '%';
+        if (conversion.leftAlign)
+        {
+            spec[position++] = '-';
+        }
+        if (conversion.plus)
+        {
+            spec[position++] = '+';
+        }
+        if (conversion.space)
+        {
+            spec[position++] = ' ';
+        }
+        if (conversion.alternate)
+        {
+            spec[position++] = '#';
+        }
+        if (conversion.zeroPad)
+        {
+            spec[position++] = '0';
+        }
+        spec[position++] = '*';
+        if (conversion.precision >= 0)
+        {
+            spec[position++] = '.';
+            spec[position++] = '*';
+        }
+        if (argument.kind == SPIN::Log::Format::ValueKind::LongFloating)
+        {
+            spec[position++] = 'L';
+        }
+        spec[position++] = conversion.conversion;
+        spec[position] = '\0';
+
+        char* room = writer.out + writer.length;
+        std::size_t roomSize = writer.capacity - writer.length;
+        int written;
+        if (argument.kind == SPIN::Log::Format::ValueKind::LongFloating)
+        {
+            written = (conversion.precision >= 0) ? snprintf(room, roomSize, spec, conversion.width, conversion.precision, *argument.longFloating)
+                                                  : snprintf(room, roomSize, spec, conversion.width, *argument.longFloating);
+        }
+        else
+        {
+            double value = (argument.kind == SPIN::Log::Format::ValueKind::Floating) ? argument.floating : (double)AsInteger(argument);
+            written = (conversion.precision >= 0) ? snprintf(room, roomSize, spec, conversion.width, conversion.precision, value)
+                                                  : snprintf(room, roomSize, spec, conversion.width, value);
+        }
+
+        if (written > 0)
+        {
+            writer.required += (std::size_t)written;
+            writer.length += ((std::size_t)written < roomSize) ? (std::size_t)written : roomSize - 1;
+        }
+    }
+
+    struct ArraySource
+    {
+        const SPIN::Log::Format::Argument* arguments;
+        std::size_t count;
+        std::size_t next;
+
+        int Star()
+        {
+            return (this->next < this->count) ? (int)AsInteger(this->arguments[this->next++]) : 0;
+        }
+        const SPIN::Log::Format::Argument* Next(const char*, std::size_t, char)
+        {
+            return (this->next < this->count) ? &(this->arguments[this->next++]) : nullptr;
+        }
+    };
+
+    // Reads each argument with the type its conversion and length modifier promise. Anything the
+    // renderer does not know marks the source unsupported so the caller can use vsnprintf instead.
+    struct ListSource
+    {
+        va_list args;
+        bool unsupported = false;
+        long double longFloating = 0;
+        SPIN::Log::Format::Argument current;
+
+        explicit ListSource(va_list list)
+        {
+            va_copy(this->args, list);
+        }
+        ~ListSource()
+        {
+            va_end(this->args);
+        }
+
+        int Star()
+        {
+            return va_arg(this->args, int);
+        }
+        const SPIN::Log::Format::Argument* Fail()
+        {
+            this->unsupported = true;
+            return nullptr;
+        }
+        const SPIN::Log::Format::Argument* Next(const char* modifier, std::size_t modifierLength, char conversion)
+        {
+            char size = (modifierLength == 0) ? '\0' : modifier[0];
+            if (modifierLength == 2)
+            {
+                size = (modifier[0] == 'h' && modifier[1] == 'h') ? 'h' : ((modifier[0] == 'l' && modifier[1] == 'l') ? 'q' : '?');
+            }
+            else if (modifierLength > 2)
+            {
+                return this->Fail();
+            }
+
+            switch (conversion)
+            {
+                case 'd':
+                case 'i':
+                    switch (size)
+                    {
+                        case '\0':
+                        case 'h':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, int));
+                            break;
+                        case 'l':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, long));
+                            break;
+                        case 'q':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, long long));
+                            break;
+                        case 'j':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, intmax_t));
+                            break;
+                        case 'z':
+                        case 't':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, ptrdiff_t));
+                            break;
+                        default:
+                            return this->Fail();
+                    }
+                    return &(this->current);
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X':
+                    switch (size)
+                    {
+                        case '\0':
+                        case 'h':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, unsigned int));
+                            break;
+                        case 'l':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, unsigned long));
+                            break;
+                        case 'q':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, unsigned long long));
+                            break;
+                        case 'j':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, uintmax_t));
+                            break;
+                        case 'z':
+                        case 't':
+                            this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, std::size_t));
+                            break;
+                        default:
+                            return this->Fail();
+                    }
+                    return &(this->current);
+                case 'c':
+                    if (size != '\0')
+                    {
+                        return this->Fail();
+                    }
+                    this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, int));
+                    return &(this->current);
+                case 's':
+                    if (size != '\0')
+                    {
+                        return this->Fail();
+                    }
+                    this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, const char*));
+                    return &(this->current);
+                case 'p':
+                    this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, const void*));
+                    return &(this->current);
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    if (size == 'L')
+                    {
+                        this->longFloating = va_arg(this->args, long double);
+                        this->current = SPIN::Log::Format::MakeArgument(this->longFloating);
+                    }
+                    else if (size == '\0' || size == 'l')
+                    {
+                        this->current = SPIN::Log::Format::MakeArgument(va_arg(this->args, double));
+                    }
+                    else
+                    {
+                        return this->Fail();
+                    }
+                    return &(this->current);
+                default:
+                    return this->Fail();
+            }
+        }
+    };
+
+    template<typename Source>
+    std::size_t Render(char* out, std::size_t capacity, const char* fmt, Source& source, std::size_t& required)
+    {
+        Writer writer = { out, capacity, 0, 0 };
+
+        while (*fmt != '\0')
+        {
+            const char* percent = strchr(fmt, '%');
+            if (percent == nullptr)
+            {
+                writer.Put(fmt, strlen(fmt));
+                break;
+            }
+            writer.Put(fmt, (std::size_t)(percent - fmt));
+
+            fmt = percent + 1;
+            if (*fmt == '%')
+            {
+                writer.Put("%", 1);
+                fmt++;
+                continue;
+            }
+
+            Conversion conversion = { false, false, false, false, false, 0, -1, '\0' };
+            for (;; fmt++)
+            {
+                if (*fmt == '-')
+                {
+                    conversion.leftAlign = true;
+                }
+                else if (*fmt == '+')
+                {
+                    conversion.plus = true;
+                }
+                else if (*fmt == ' ')
+                {
+                    conversion.space = true;
+                }
+                else if (*fmt == '#')
+                {
+                    conversion.alternate = true;
+                }
+                else if (*fmt == '0')
+                {
+                    conversion.zeroPad = true;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            if (*fmt == '*')
+            {
+                fmt++;
+                conversion.width = source.Star();
+                if (conversion.width < 0)
+                {
+                    conversion.leftAlign = true;
+                    conversion.width = -conversion.width;
+                }
+            }
+            while (*fmt >= '0' && *fmt <= '9')
+            {
+                conversion.width = conversion.width * 10 + (*fmt++ - '0');
+            }
+
+            if (*fmt == '.')
+            {
+                fmt++;
+                conversion.precision = 0;
+                if (*fmt == '*')
+                {
+                    fmt++;
+                    conversion.precision = source.Star();
+                    if (conversion.precision < 0)
+                    {
+                        conversion.precision = -1;
+                    }
+                }
+                while (*fmt >= '0' && *fmt <= '9')
+                {
+                    conversion.precision = conversion.precision * 10 + (*fmt++ - '0');
+                }
+            }
+
+            const char* modifier = fmt;
+            while (*fmt == 'h' || *fmt == 'l' || *fmt == 'L' || *fmt == 'j' || *fmt == 'z' || *fmt == 't' || *fmt == 'q')
+            {
+                fmt++;
+            }
+            std::size_t modifierLength = (std::size_t)(fmt - modifier);
+            // printf converts the promoted argument back for h and hh.
+            uint32_t narrow = (modifierLength == 2 && modifier[0] == 'h') ? 8 : ((modifierLength == 1 && modifier[0] == 'h') ? 16 : 0);
+
+            conversion.conversion = *fmt;
+            const SPIN::Log::Format::Argument* next = (*fmt == '\0') ? nullptr : source.Next(modifier, modifierLength, *fmt);
+            if (next == nullptr)
+            {
+                writer.Put(percent, strlen(percent));
+                break;
+            }
+            fmt++;
+
+            const SPIN::Log::Format::Argument& argument = *next;
+            switch (conversion.conversion)
+            {
+                case 'd':
+                case 'i':
+                {
+                    int64_t value = AsInteger(argument);
+                    if (narrow != 0)
+                    {
+                        value = (narrow == 8) ? (int64_t)(signed char)value : (int64_t)(short)value;
+                    }
+
+                    if (narrow == 0 && argument.kind == SPIN::Log::Format::ValueKind::Unsigned)
+                    {
+                        WriteInteger(writer, conversion, argument.unsignedInteger, false);
+                    }
+                    else
+                    {
+                        WriteInteger(writer, conversion, (value < 0) ? (uint64_t)0 - (uint64_t)value : (uint64_t)value, value < 0);
+                    }
+                    break;
+                }
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X':
+                    WriteInteger(writer, conversion, (narrow != 0) ? AsUnsigned(argument) & ((1ULL << narrow) - 1) : AsUnsigned(argument), false);
+                    break;
+                case 'c':
+                {
+                    char character = (char)AsInteger(argument);
+                    WriteText(writer, conversion, &character, 1);
+                    break;
+                }
+                case 's':
+                {
+                    const char* text = (argument.kind == SPIN::Log::Format::ValueKind::String && argument.string != nullptr) ? argument.string : "(null)";
+                    // With a precision the text need not be terminated, so no byte past it is read.
+                    std::size_t length = 0;
+                    if (conversion.precision >= 0)
+                    {
+                        while (length < (std::size_t)(conversion.precision) && text[length] != '\0')
+                        {
+                            length++;
+                        }
+                    }
+                    else
+                    {
+                        length = strlen(text);
+                    }
+                    WriteText(writer, conversion, text, length);
+                    break;
+                }
+                case 'p':
+                {
+                    if (argument.pointer == nullptr)
+                    {
+                        WriteText(writer, conversion, "(nil)", 5);
+                        break;
+                    }
+                    conversion.conversion = 'x';
+                    conversion.alternate = true;
+                    WriteInteger(writer, conversion, (uint64_t)(uintptr_t)(argument.pointer), false);
+                    break;
+                }
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    WriteFloating(writer, conversion, argument);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        writer.out[writer.length] = '\0';
+        required = writer.required;
+
+        return writer.length;
+    }
+}
+
+
+std::size_t SPIN::Log::Format::FormatArguments(char* out, std::size_t capacity, const char* fmt, const SPIN::Log::Format::Argument* arguments, std::size_t count)
+{
+    std::size_t required;
+
+    return SPIN::Log::Format::FormatArguments(out, capacity, fmt, arguments, count, required);
+}
+std::size_t SPIN::Log::Format::FormatArguments(char* out, std::size_t capacity, const char* fmt, const SPIN::Log::Format::Argument* arguments, std::size_t count, std::size_t& required)
+{
+    required = 0;
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    ArraySource source = { arguments, count, 0 };
+
+    return Render(out, capacity, fmt, source, required);
+}
+std::size_t SPIN::Log::Format::FormatArgumentList(char* out, std::size_t capacity, const char* fmt, va_list args)
+{
+    std::size_t required;
+
+    return SPIN::Log::Format::FormatArgumentList(out, capacity, fmt, args, required);
+}
+std::size_t SPIN::Log::Format::FormatArgumentList(char* out, std::size_t capacity, const char* fmt, va_list args, std::size_t& required)
+{
+    required = 0;
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    ListSource source(args);
+    std::size_t length = Render(out, capacity, fmt, source, required);
+    if (!source.unsupported)
+    {
+        return length;
+    }
+
+    va_list fallback;
+    va_copy(fallback, args);
+    int written = vsnprintf(out, capacity, fmt, fallback);
+    va_end(fallback);
+
+    required = (written < 0) ? 0 : (std::size_t)written;
+
+    return (written < 0) ? 0 : ((std::size_t)written < capacity ? (std::size_t)written : capacity - 1);
+}
@@ -0,0 +1,307 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FORMAT__TYPEDFORMAT__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FORMAT__TYPEDFORMAT__H__
+
+#ifdef ARDUINO
+    #include <stdarg.h>
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstdarg>
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Format
+        {
+            enum class ValueKind : uint8_t
+            {
+                Unsupported = 0,
+                Signed = 1,
+                Unsigned = 2,
+                Floating = 3,
+                LongFloating = 4,
+                String = 5,
+                Pointer = 6
+            };
+
+            /**
+             * One argument of the typed API, captured by its static type so rendering never needs va_arg.
+             * Long doubles are referenced rather than copied, the argument only lives for the call.
+             **/
+            struct Argument
+            {
+                SPIN::Log::Format::ValueKind kind;
+                uint8_t size;
+                union
+                {
+                    int64_t integer;
+                    uint64_t unsignedInteger;
+                    double floating;
+                    const long double* longFloating;
+                    const char* string;
+                    const void* pointer;
+                };
+            };
+
+            template<typename T> struct KindOf { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::Unsupported; };
+            template<typename T> struct KindOf<const T> : KindOf<T> {};
+            template<typename T> struct KindOf<volatile T> : KindOf<T> {};
+            template<typename T> struct KindOf<const volatile T> : KindOf<T> {};
+            template<typename T> struct KindOf<T&> : KindOf<T> {};
+            template<typename T> struct KindOf<T*> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::Pointer; };
+            template<> struct KindOf<char*> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::String; };
+            template<> struct KindOf<const char*> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::String; };
+            template<std::size_t N> struct KindOf<char[N]> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::String; };
+            template<std::size_t N> struct KindOf<const char[N]> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::String; };
+
+            #define __LOGGER__SPIN__LOG__FORMAT__KIND__(type, valueKind) \
+                template<> struct KindOf<type> { static constexpr SPIN::Log::Format::ValueKind value = SPIN::Log::Format::ValueKind::valueKind; };
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(bool, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(char, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(signed char, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(unsigned char, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(short, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(unsigned short, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(int, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(unsigned int, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(long, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(unsigned long, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(long long, Signed)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(unsigned long long, Unsigned)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(float, Floating)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(double, Floating)
+            __LOGGER__SPIN__LOG__FORMAT__KIND__(long double, LongFloating)
+            #undef __LOGGER__SPIN__LOG__FORMAT__KIND__
+
+            template<typename T, SPIN::Log::Format::ValueKind kind = SPIN::Log::Format::KindOf<T>::value>
+            struct ArgumentMaker
+            {
+                static_assert(kind != SPIN::Log::Format::ValueKind::Unsupported, "Type cannot be passed to the typed logging API");
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::Signed>
+            {
+                static SPIN::Log::Format::Argument Make(const T& value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::Signed;
+                    argument.size = (uint8_t)sizeof(T);
+                    argument.integer = (int64_t)value;
+                    return argument;
+                }
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::Unsigned>
+            {
+                static SPIN::Log::Format::Argument Make(const T& value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::Unsigned;
+                    argument.size = (uint8_t)sizeof(T);
+                    argument.unsignedInteger = (uint64_t)value;
+                    return argument;
+                }
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::Floating>
+            {
+                static SPIN::Log::Format::Argument Make(const T& value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::Floating;
+                    argument.size = (uint8_t)sizeof(double);
+                    argument.floating = (double)value;
+                    return argument;
+                }
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::LongFloating>
+            {
+                static SPIN::Log::Format::Argument Make(const T& value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::LongFloating;
+                    argument.size = (uint8_t)sizeof(long double);
+                    argument.longFloating = &value;
+                    return argument;
+                }
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::String>
+            {
+                static SPIN::Log::Format::Argument Make(const char* value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::String;
+                    argument.size = (uint8_t)sizeof(const char*);
+                    argument.string = value;
+                    return argument;
+                }
+            };
+            template<typename T>
+            struct ArgumentMaker<T, SPIN::Log::Format::ValueKind::Pointer>
+            {
+                static SPIN::Log::Format::Argument Make(const void* value)
+                {
+                    SPIN::Log::Format::Argument argument;
+                    argument.kind = SPIN::Log::Format::ValueKind::Pointer;
+                    argument.size = (uint8_t)sizeof(const void*);
+                    argument.pointer = value;
+                    return argument;
+                }
+            };
+
+            template<typename T>
+            SPIN::Log::Format::Argument MakeArgument(const T& value)
+            {
+                return SPIN::Log::Format::ArgumentMaker<T>::Make(value);
+            }
+
+            /**
+             * Renders the format with the captured arguments, output matches snprintf for every
+             * argument whose type fits its conversion. Returns the length written, excluding the terminator.
+             **/
+            std::size_t FormatArguments(char*, std::size_t, const char*, const SPIN::Log::Format::Argument*, std::size_t);
+            /**
+             * Same as above, required receives the full length of the line, which is larger than
+             * the returned length when the line did not fit.
+             **/
+            std::size_t FormatArguments(char*, std::size_t, const char*, const SPIN::Log::Format::Argument*, std::size_t, std::size_t& required);
+            /**
+             * Drop in for vsnprintf with the same renderer, arguments are read by their conversion
+             * and length modifier. Conversions it does not handle (%n, %ls, grouping flags...) make
+             * it hand the whole line to vsnprintf. args is not consumed.
+             **/
+            std::size_t FormatArgumentList(char*, std::size_t, const char*, va_list);
+            std::size_t FormatArgumentList(char*, std::size_t, const char*, va_list, std::size_t& required);
+
+            /**
+             * Compile time format checking: FormatMatches(fmt, TypeList<Args...>()) is a constant
+             * expression that is true when every conversion (including '*' widths and precisions)
+             * has an argument of a fitting kind and no argument is left over.
+             **/
+            template<typename... Types> struct TypeList {};
+
+            template<typename... Args>
+            SPIN::Log::Format::TypeList<Args...> ArgumentTypes(const char*, const Args&...);
+
+            constexpr bool Accepts(char conversion, SPIN::Log::Format::ValueKind kind)
+            {
+                return (conversion == 'd' || conversion == 'i' || conversion == 'u' || conversion == 'o'
+                        || conversion == 'x' || conversion == 'X' || conversion == 'c')
+                           ? (kind == SPIN::Log::Format::ValueKind::Signed || kind == SPIN::Log::Format::ValueKind::Unsigned)
+                       : (conversion == 'f' || conversion == 'F' || conversion == 'e' || conversion == 'E'
+                          || conversion == 'g' || conversion == 'G' || conversion == 'a' || conversion == 'A')
+                           ? (kind == SPIN::Log::Format::ValueKind::Floating || kind == SPIN::Log::Format::ValueKind::LongFloating)
+                       : (conversion == 's')
+                           ? kind == SPIN::Log::Format::ValueKind::String
+                       : (conversion == 'p')
+                           ? (kind == SPIN::Log::Format::ValueKind::Pointer || kind == SPIN::Log::Format::ValueKind::String)
+                           : false;
+            }
+            constexpr bool IsInteger(SPIN::Log::Format::ValueKind kind)
+            {
+                return kind == SPIN::Log::Format::ValueKind::Signed || kind == SPIN::Log::Format::ValueKind::Unsigned;
+            }
+
+            constexpr const char* NextConversion(const char* fmt)
+            {
+                return (*fmt == '\0') ? fmt
+                       : (*fmt != '%') ? NextConversion(fmt + 1)
+                       : (fmt[1] == '%') ? NextConversion(fmt + 2)
+                       : fmt + 1;
+            }
+            constexpr const char* SkipFlags(const char* fmt)
+            {
+                return (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') ? SkipFlags(fmt + 1) : fmt;
+            }
+            constexpr const char* SkipDigits(const char* fmt)
+            {
+                return (*fmt >= '0' && *fmt <= '9') ? SkipDigits(fmt + 1) : fmt;
+            }
+            constexpr const char* SkipLength(const char* fmt)
+            {
+                return (*fmt == 'h' || *fmt == 'l' || *fmt == 'L' || *fmt == 'j' || *fmt == 'z' || *fmt == 't' || *fmt == 'q') ? SkipLength(fmt + 1) : fmt;
+            }
+
+            constexpr bool FormatMatches(const char* fmt, SPIN::Log::Format::TypeList<>)
+            {
+                return *SPIN::Log::Format::NextConversion(fmt) == '\0';
+            }
+            template<typename T, typename... Rest>
+            constexpr bool FormatMatches(const char*, SPIN::Log::Format::TypeList<T, Rest...>);
+
+            constexpr bool MatchConversion(const char*, SPIN::Log::Format::TypeList<>)
+            {
+                return false;
+            }
+            template<typename T, typename... Rest>
+            constexpr bool MatchConversion(const char* fmt, SPIN::Log::Format::TypeList<T, Rest...>)
+            {
+                return SPIN::Log::Format::Accepts(*fmt, SPIN::Log::Format::KindOf<T>::value)
+                       && SPIN::Log::Format::FormatMatches(fmt + 1, SPIN::Log::Format::TypeList<Rest...>());
+            }
+
+            constexpr bool MatchPrecision(const char*, SPIN::Log::Format::TypeList<>)
+            {
+                return false;
+            }
+            template<typename T, typename... Rest>
+            constexpr bool MatchPrecision(const char* fmt, SPIN::Log::Format::TypeList<T, Rest...>)
+            {
+                return (*fmt == '.' && fmt[1] == '*')
+                           ? SPIN::Log::Format::IsInteger(SPIN::Log::Format::KindOf<T>::value)
+                             && SPIN::Log::Format::MatchConversion(SPIN::Log::Format::SkipLength(fmt + 2), SPIN::Log::Format::TypeList<Rest...>())
+                       : (*fmt == '.')
+                           ? SPIN::Log::Format::MatchConversion(SPIN::Log::Format::SkipLength(SPIN::Log::Format::SkipDigits(fmt + 1)), SPIN::Log::Format::TypeList<T, Rest...>())
+                           : SPIN::Log::Format::MatchConversion(SPIN::Log::Format::SkipLength(fmt), SPIN::Log::Format::TypeList<T, Rest...>());
+            }
+
+            template<typename T, typename... Rest>
+            constexpr bool MatchWidth(const char* fmt, SPIN::Log::Format::TypeList<T, Rest...>)
+            {
+                return (*fmt == '*')
+                           ? SPIN::Log::Format::IsInteger(SPIN::Log::Format::KindOf<T>::value)
+                             && SPIN::Log::Format::MatchPrecision(fmt + 1, SPIN::Log::Format::TypeList<Rest...>())
+                           : SPIN::Log::Format::MatchPrecision(SPIN::Log::Format::SkipDigits(fmt), SPIN::Log::Format::TypeList<T, Rest...>());
+            }
+
+            template<typename T, typename... Rest>
+            constexpr bool FormatMatches(const char* fmt, SPIN::Log::Format::TypeList<T, Rest...>)
+            {
+                return *SPIN::Log::Format::NextConversion(fmt) != '\0'
+                       && SPIN::Log::Format::MatchWidth(SPIN::Log::Format::SkipFlags(SPIN::Log::Format::NextConversion(fmt)), SPIN::Log::Format::TypeList<T, Rest...>());
+            }
+        }
+    }
+}
+
+#endif
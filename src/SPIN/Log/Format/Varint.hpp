@@ -0,0 +1,84 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__FORMAT__VARINT__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__FORMAT__VARINT__H__
+
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Format
+        {
+            constexpr std::size_t MaximumVarintSize = 10;
+
+            inline uint64_t ZigZagEncode(int64_t value)
+            {
+                return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+            }
+            inline int64_t ZigZagDecode(uint64_t value)
+            {
+                return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+            }
+
+            inline std::size_t WriteVarint(uint64_t value, uint8_t* out)
+            {
+                std::size_t written = 0;
+                while (value >= 0x80)
+                {
+                    out[written++] = (uint8_t)(value | 0x80);
+                    value >>= 7;
+                }
+                out[written++] = (uint8_t)value;
+
+                return written;
+            }
+            inline bool ReadVarint(const uint8_t* in, std::size_t length, std::size_t& position, uint64_t& value)
+            {
+                value = 0;
+                for (uint8_t shift = 0; shift < 64 && position < length; shift += 7)
+                {
+                    uint8_t byte = in[position++];
+                    value |= (uint64_t)(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+        }
+    }
+}
+
+#endif
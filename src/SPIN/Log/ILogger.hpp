@@ -28,17 +28,23 @@
 #ifdef ARDUINO
     #include <stdarg.h>
     #include <stddef.h>
+    #include <stdint.h>
     #include <stdlib.h>
     #include <string.h>
 #else
     #include <cstdarg>
     #include <cstddef>
+    #include <cstdint>
     #include <cstdlib>
     #include <cstring>
     #include <exception>
 #endif
 
+#include <SPIN/Log/LoggerFrontEnd.hpp>
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Metrics.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
 #include <SPIN/Log/Sinks/ISink.hpp>
 
 namespace SPIN
@@ -46,17 +52,59 @@ namespace SPIN
     namespace Log
     {
         template<std::size_t bufferSize>
-        class ILogger
+        class ILogger : public SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>
         {
             protected:
                 char _buffer[bufferSize] = { 0 };
                 SPIN::Log::Sinks::ISink** _sinks = nullptr;
                 std::size_t _numberOfSinks = 0;
 
-                virtual void LogExpansion(SPIN::Log::LogLevel, const char*, va_list) = 0;
+                /**
+                 * Receives the record with everything but the message filled in, the format is in record.format.
+                 **/
+                virtual void LogExpansion(SPIN::Log::LogRecord&, va_list) = 0;
+                /**
+                 * Same as LogExpansion for the typed API, the arguments are already captured by type.
+                 **/
+                virtual void LogArguments(SPIN::Log::LogRecord&, const SPIN::Log::Format::Argument*, std::size_t) = 0;
+
+                uint8_t GetLowestSinkLevel() const
+                {
+                    uint8_t lowestSinkLevel = SPIN_LOG_LEVEL_OFF;
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        uint8_t sinkLevel = (uint8_t)(this->_sinks[i]->GetMinimumLevel());
+                        if (sinkLevel < lowestSinkLevel)
+                        {
+                            lowestSinkLevel = sinkLevel;
+                        }
+                    }
+
+                    return lowestSinkLevel;
+                }
+#ifndef ARDUINO
+                void EnableSinkMetrics(bool enable)
+                {
+                    for (std::size_t i = 0; i < this->_numberOfSinks; i++)
+                    {
+                        this->_sinks[i]->EnableMetrics(enable);
+                    }
+                }
+                std::size_t GetSinkCount() const
+                {
+                    return this->_numberOfSinks;
+                }
+                bool GetSinkMetrics(std::size_t index, SPIN::Log::Metrics::SinkSnapshot& snapshot) const
+                {
+                    return this->_sinks[index]->GetMetrics(snapshot);
+                }
+#endif
+
+                friend class SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>;
+
             public:
                 ILogger() = default;
-                ILogger(const ILogger<bufferSize>& obj)
+                ILogger(const ILogger<bufferSize>& obj) : SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>(obj)
                 {
                     this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
                     if (this->_sinks == nullptr)
@@ -71,7 +119,7 @@ namespace SPIN
 
                     memcpy((void*)(this->_buffer), (const void*)(obj._buffer), bufferSize * sizeof(char));
                 }
-                ILogger(ILogger<bufferSize>&& deadObj) noexcept
+                ILogger(ILogger<bufferSize>&& deadObj) noexcept : SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>(static_cast<ILogger<bufferSize>&&>(deadObj))
                 {
                     this->_sinks = deadObj._sinks;
                     this->_numberOfSinks = deadObj._numberOfSinks;
@@ -81,72 +129,9 @@ namespace SPIN
                     deadObj._numberOfSinks = 0;
                 }
 
-                void Log(SPIN::Log::LogLevel logLevel, const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(logLevel, fmt, args);
-
-                    va_end(args);
-                }
-                void Verbose(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Verbose, fmt, args);
-
-                    va_end(args);
-                }
-                void Debug(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Debug, fmt, args);
-
-                    va_end(args);
-                }
-                void Information(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Information, fmt, args);
-
-                    va_end(args);
-                }
-                void Warning(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Warning, fmt, args);
-
-                    va_end(args);
-                }
-                void Error(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Error, fmt, args);
-
-                    va_end(args);
-                }
-                void Fatal(const char* fmt, ...)
-                {
-                    va_list args;
-                    va_start(args, fmt);
-
-                    this->LogExpansion(SPIN::Log::LogLevel::Fatal, fmt, args);
-
-                    va_end(args);
-                }
-
-                void Flush()
+                virtual void Flush()
                 {
+                    this->ReportSuppressed();
                     if (this->_sinks == nullptr)
                     {
                         return;
@@ -154,21 +139,33 @@ namespace SPIN
 
                     for (std::size_t i = 0; i < this->_numberOfSinks; i++)
                     {
-                        this->_sinks[i]->Flush();
+                        this->_sinks[i]->DeliverFlush();
                     }
                 }
 
                 ILogger<bufferSize>& operator=(const ILogger<bufferSize>& obj)
                 {
-                    this->_sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
-                    if (this->_sinks == nullptr)
+                    if (this == &obj)
+                    {
+                        return *this;
+                    }
+
+                    SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>::operator=(obj);
+
+                    SPIN::Log::Sinks::ISink** sinks = (SPIN::Log::Sinks::ISink**)malloc(obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+                    if (sinks == nullptr)
                     {
 #ifndef ARDUINO
                         throw std::exception();
 #endif
                         return *this;
                     }
-                    memcpy((void*)(this->_sinks), (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+                    memcpy((void*)sinks, (const void*)(obj._sinks), obj._numberOfSinks * sizeof(SPIN::Log::Sinks::ISink*));
+                    if (this->_sinks != nullptr)
+                    {
+                        free((void*)(this->_sinks));
+                    }
+                    this->_sinks = sinks;
                     this->_numberOfSinks = obj._numberOfSinks;
 
                     memcpy((void*)(this->_buffer), (const void*)(obj._buffer), bufferSize * sizeof(char));
@@ -177,6 +174,16 @@ namespace SPIN
                 }
                 ILogger<bufferSize>& operator=(ILogger<bufferSize>&& deadObj) noexcept
                 {
+                    if (this == &deadObj)
+                    {
+                        return *this;
+                    }
+
+                    SPIN::Log::LoggerFrontEnd<SPIN::Log::ILogger<bufferSize>, bufferSize>::operator=(static_cast<ILogger<bufferSize>&&>(deadObj));
+                    if (this->_sinks != nullptr)
+                    {
+                        free((void*)(this->_sinks));
+                    }
                     this->_sinks = deadObj._sinks;
                     this->_numberOfSinks = deadObj._numberOfSinks;
                     memcpy((void*)(this->_buffer), (const void*)(deadObj._buffer), bufferSize * sizeof(char));
@@ -186,6 +193,16 @@ namespace SPIN
 
                     return *this;
                 }
+
+                virtual ~ILogger()
+                {
+                    if (this->_sinks != nullptr)
+                    {
+                        free((void*)(this->_sinks));
+                    }
+                    this->_sinks = nullptr;
+                    this->_numberOfSinks = 0;
+                }
         };
     }
 }
@@ -27,6 +27,22 @@
 
 #include <stdint.h>
 
+#define SPIN_LOG_LEVEL_VERBOSE 0
+#define SPIN_LOG_LEVEL_DEBUG 1
+#define SPIN_LOG_LEVEL_INFORMATION 2
+#define SPIN_LOG_LEVEL_WARNING 3
+#define SPIN_LOG_LEVEL_ERROR 4
+#define SPIN_LOG_LEVEL_FATAL 5
+#define SPIN_LOG_LEVEL_OFF 6
+
+/**
+ * Calls below this level are compiled out. Define it before including the library,
+ * e.g. -DSPIN_LOG_MIN_LEVEL=SPIN_LOG_LEVEL_INFORMATION for flight builds.
+ **/
+#ifndef SPIN_LOG_MIN_LEVEL
+    #define SPIN_LOG_MIN_LEVEL SPIN_LOG_LEVEL_VERBOSE
+#endif
+
 namespace SPIN
 {
     namespace Log
@@ -40,6 +56,15 @@ namespace SPIN
             Error = 4,
             Fatal = 5
         };
+
+        constexpr bool IsCompiledIn(SPIN::Log::LogLevel logLevel)
+        {
+#if SPIN_LOG_MIN_LEVEL > SPIN_LOG_LEVEL_VERBOSE
+            return (int)logLevel >= (int)SPIN_LOG_MIN_LEVEL;
+#else
+            return ((void)logLevel, true);
+#endif
+        }
     }
 }
 
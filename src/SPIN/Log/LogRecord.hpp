@@ -0,0 +1,72 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__LOGRECORD__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__LOGRECORD__H__
+
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+#include <SPIN/Log/LogLevel.hpp>
+
+/**
+ * Call site of the record, filled in by the SPIN_LOG_* macros.
+ **/
+#define SPIN_LOG_SOURCE_LOCATION (SPIN::Log::SourceLocation{ __FILE__, (uint32_t)(__LINE__), __func__ })
+
+namespace SPIN
+{
+    namespace Log
+    {
+        struct SourceLocation
+        {
+            const char* file;
+            uint32_t line;
+            const char* function;
+        };
+
+        /**
+         * Everything the logger knows about one record, captured once in ILogger and read by
+         * every sink. The message is NUL terminated, length excludes the terminator. The format
+         * is the caller's format string, message is null while the record is still unrendered.
+         **/
+        struct LogRecord
+        {
+            SPIN::Log::LogLevel level;
+            const char* message;
+            std::size_t length;
+            const char* format;
+            uint64_t timestamp;
+            uint32_t threadId;
+            SPIN::Log::SourceLocation location;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,523 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+
+#if !defined(__LOGGER__SPIN__LOG__LOGGERFRONTEND__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__LOGGERFRONTEND__H__
+
+#ifdef ARDUINO
+    #include <stdarg.h>
+    #include <stddef.h>
+    #include <stdint.h>
+    #include <stdlib.h>
+#else
+    #include <cstdarg>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdlib>
+    #include <exception>
+    #include <new>
+#endif
+
+#include <SPIN/Log/Clock.hpp>
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Metrics.hpp>
+#include <SPIN/Log/StormSuppressor.hpp>
+#include <SPIN/Log/Thread.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        /**
+         * The part of a logger every record goes through before it reaches the sinks: level
+         * gating, record construction, storm suppression and metrics. The Logger it is mixed
+         * into provides LogExpansion and LogArguments, which hand the record to its sinks, and
+         * GetLowestSinkLevel, EnableSinkMetrics, GetSinkCount and GetSinkMetrics.
+         **/
+        template<typename Logger, std::size_t bufferSize>
+        class LoggerFrontEnd
+        {
+            protected:
+                SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+                uint8_t _enabledLevel = SPIN_LOG_LEVEL_VERBOSE;
+                SPIN::Log::StormSuppressor* _suppressor = nullptr;
+#ifndef ARDUINO
+                SPIN::Log::Metrics::LoggerMetrics* _metrics = nullptr;
+#endif
+
+                static SPIN::Log::LogRecord MakeRecord(const SPIN::Log::SourceLocation& location, SPIN::Log::LogLevel logLevel, const char* fmt)
+                {
+                    SPIN::Log::LogRecord record;
+                    record.level = logLevel;
+                    record.message = nullptr;
+                    record.length = 0;
+                    record.format = fmt;
+                    record.timestamp = SPIN::Log::Clock::Microseconds();
+                    record.threadId = SPIN::Log::Thread::CurrentId();
+                    record.location = location;
+
+                    return record;
+                }
+                void Dispatch(const SPIN::Log::SourceLocation& location, SPIN::Log::LogLevel logLevel, const char* fmt, va_list args)
+                {
+                    SPIN::Log::LogRecord record = MakeRecord(location, logLevel, fmt);
+                    if (this->_suppressor != nullptr && !this->Admit(record))
+                    {
+                        return;
+                    }
+                    this->CountRecord(record);
+
+                    static_cast<Logger*>(this)->LogExpansion(record, args);
+                }
+                /**
+                 * Asks the storm suppressor about the record, a pending repeat count is logged ahead of it.
+                 **/
+                bool Admit(const SPIN::Log::LogRecord& record)
+                {
+                    uint64_t repeats;
+                    if (!this->_suppressor->Admit(record.format, record.location, record.level, record.timestamp, repeats))
+                    {
+                        return false;
+                    }
+
+                    if (repeats > 0)
+                    {
+                        this->LogRepeats(record, record.format, repeats);
+                    }
+                    return true;
+                }
+                void LogRepeats(const SPIN::Log::LogRecord& original, const char* fmt, uint64_t repeats)
+                {
+                    static const char* repeatsFormat = "Previous message repeated %llu more times: %s";
+
+                    const SPIN::Log::Format::Argument arguments[2] = { SPIN::Log::Format::MakeArgument((unsigned long long)repeats), SPIN::Log::Format::MakeArgument(fmt) };
+                    SPIN::Log::LogRecord record = original;
+                    record.format = repeatsFormat;
+
+                    static_cast<Logger*>(this)->LogArguments(record, arguments, 2);
+                }
+                void CountRecord(const SPIN::Log::LogRecord& record)
+                {
+#ifndef ARDUINO
+                    if (this->_metrics == nullptr)
+                    {
+                        return;
+                    }
+
+                    this->_metrics->CountRecord(record.level);
+                    if (this->_metrics->ReportDue(record.timestamp) && this->IsEnabled(SPIN::Log::LogLevel::Information))
+                    {
+                        this->LogMetrics();
+                    }
+#else
+                    (void)record;
+#endif
+                }
+                /**
+                 * A render that filled the whole buffer is counted as truncated.
+                 **/
+                void CountRendered(std::size_t length)
+                {
+#ifndef ARDUINO
+                    if (this->_metrics != nullptr && length + 1 >= bufferSize)
+                    {
+                        this->_metrics->CountTruncated();
+                    }
+#else
+                    (void)length;
+#endif
+                }
+#ifndef ARDUINO
+                void LogMetrics()
+                {
+                    static const char* loggerFormat = "Metrics: records verbose %llu, debug %llu, information %llu, warning %llu, error %llu, fatal %llu, truncated %llu";
+                    static const char* sinkFormat = "Metrics: sink %u wrote %llu records, %llu bytes, handle p50 %llu ns, p99 %llu ns, max %llu ns, flush p99 %llu ns";
+
+                    Logger* logger = static_cast<Logger*>(this);
+                    SPIN::Log::Metrics::LoggerSnapshot snapshot = this->_metrics->Snapshot();
+                    SPIN::Log::Format::Argument arguments[7];
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        arguments[i] = SPIN::Log::Format::MakeArgument((unsigned long long)(snapshot.records[i]));
+                    }
+                    arguments[6] = SPIN::Log::Format::MakeArgument((unsigned long long)(snapshot.truncated));
+
+                    SPIN::Log::LogRecord record = MakeRecord(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Information, loggerFormat);
+                    logger->LogArguments(record, arguments, 7);
+
+                    for (std::size_t i = 0; i < logger->GetSinkCount(); i++)
+                    {
+                        SPIN::Log::Metrics::SinkSnapshot sink;
+                        if (!logger->GetSinkMetrics(i, sink))
+                        {
+                            continue;
+                        }
+
+                        arguments[0] = SPIN::Log::Format::MakeArgument((unsigned int)i);
+                        arguments[1] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.records));
+                        arguments[2] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.bytes));
+                        arguments[3] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.handle.Percentile(0.5)));
+                        arguments[4] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.handle.Percentile(0.99)));
+                        arguments[5] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.handle.maximum));
+                        arguments[6] = SPIN::Log::Format::MakeArgument((unsigned long long)(sink.flush.Percentile(0.99)));
+
+                        record = MakeRecord(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Information, sinkFormat);
+                        logger->LogArguments(record, arguments, 7);
+                    }
+                }
+#endif
+
+                LoggerFrontEnd() = default;
+                LoggerFrontEnd(const LoggerFrontEnd<Logger, bufferSize>& obj)
+                {
+                    this->_minimumLevel = obj._minimumLevel;
+                    this->_enabledLevel = obj._enabledLevel;
+                    this->_suppressor = obj._suppressor;
+                }
+                LoggerFrontEnd(LoggerFrontEnd<Logger, bufferSize>&& deadObj) noexcept
+                {
+                    this->_minimumLevel = deadObj._minimumLevel;
+                    this->_enabledLevel = deadObj._enabledLevel;
+                    this->_suppressor = deadObj._suppressor;
+#ifndef ARDUINO
+                    this->_metrics = deadObj._metrics;
+                    deadObj._metrics = nullptr;
+#endif
+                }
+
+                LoggerFrontEnd<Logger, bufferSize>& operator=(const LoggerFrontEnd<Logger, bufferSize>& obj)
+                {
+                    this->_minimumLevel = obj._minimumLevel;
+                    this->_enabledLevel = obj._enabledLevel;
+                    this->_suppressor = obj._suppressor;
+
+                    return *this;
+                }
+                LoggerFrontEnd<Logger, bufferSize>& operator=(LoggerFrontEnd<Logger, bufferSize>&& deadObj) noexcept
+                {
+                    if (this == &deadObj)
+                    {
+                        return *this;
+                    }
+
+                    this->_minimumLevel = deadObj._minimumLevel;
+                    this->_enabledLevel = deadObj._enabledLevel;
+                    this->_suppressor = deadObj._suppressor;
+#ifndef ARDUINO
+                    this->DestroyMetrics();
+                    this->_metrics = deadObj._metrics;
+                    deadObj._metrics = nullptr;
+#endif
+
+                    return *this;
+                }
+
+                ~LoggerFrontEnd()
+                {
+#ifndef ARDUINO
+                    this->DestroyMetrics();
+#endif
+                }
+
+            public:
+                void Log(SPIN::Log::LogLevel logLevel, const char* fmt, ...)
+                {
+                    if (!SPIN::Log::IsCompiledIn(logLevel) || !this->IsEnabled(logLevel))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), logLevel, fmt, args);
+
+                    va_end(args);
+                }
+                void LogAt(const SPIN::Log::SourceLocation& location, SPIN::Log::LogLevel logLevel, const char* fmt, ...)
+                {
+                    if (!SPIN::Log::IsCompiledIn(logLevel) || !this->IsEnabled(logLevel))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(location, logLevel, fmt, args);
+
+                    va_end(args);
+                }
+
+                /**
+                 * Typed counterpart of Log: arguments are captured by their static type and rendered
+                 * without va_arg or vsnprintf. Use SPIN_LOG_TYPED to also check the format at compile time.
+                 **/
+                template<typename... Args>
+                void LogTyped(SPIN::Log::LogLevel logLevel, const char* fmt, const Args&... args)
+                {
+                    this->LogTypedAt(SPIN::Log::SourceLocation(), logLevel, fmt, args...);
+                }
+                template<typename... Args>
+                void LogTypedAt(const SPIN::Log::SourceLocation& location, SPIN::Log::LogLevel logLevel, const char* fmt, const Args&... args)
+                {
+                    if (!SPIN::Log::IsCompiledIn(logLevel) || !this->IsEnabled(logLevel))
+                    {
+                        return;
+                    }
+
+                    SPIN::Log::LogRecord record = MakeRecord(location, logLevel, fmt);
+                    if (this->_suppressor != nullptr && !this->Admit(record))
+                    {
+                        return;
+                    }
+                    this->CountRecord(record);
+
+                    const SPIN::Log::Format::Argument arguments[sizeof...(Args) + 1] = { SPIN::Log::Format::MakeArgument(args)..., SPIN::Log::Format::Argument() };
+
+                    static_cast<Logger*>(this)->LogArguments(record, arguments, sizeof...(Args));
+                }
+
+                void Verbose(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_VERBOSE
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Verbose))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Verbose, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+                void Debug(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_DEBUG
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Debug))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Debug, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+                void Information(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_INFORMATION
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Information))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Information, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+                void Warning(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_WARNING
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Warning))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Warning, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+                void Error(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_ERROR
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Error))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Error, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+                void Fatal(const char* fmt, ...)
+                {
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_FATAL
+                    if (!this->IsEnabled(SPIN::Log::LogLevel::Fatal))
+                    {
+                        return;
+                    }
+
+                    va_list args;
+                    va_start(args, fmt);
+
+                    this->Dispatch(SPIN::Log::SourceLocation(), SPIN::Log::LogLevel::Fatal, fmt, args);
+
+                    va_end(args);
+#else
+                    (void)fmt;
+#endif
+                }
+
+                bool IsEnabled(SPIN::Log::LogLevel logLevel) const
+                {
+                    return (uint8_t)logLevel >= this->_enabledLevel;
+                }
+
+                SPIN::Log::LogLevel GetMinimumLevel() const
+                {
+                    return this->_minimumLevel;
+                }
+                void SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+                {
+                    this->_minimumLevel = logLevel;
+                    this->RefreshLevels();
+                }
+                void RefreshLevels()
+                {
+                    uint8_t lowestSinkLevel = static_cast<Logger*>(this)->GetLowestSinkLevel();
+
+                    this->_enabledLevel = ((uint8_t)(this->_minimumLevel) > lowestSinkLevel) ? (uint8_t)(this->_minimumLevel) : lowestSinkLevel;
+                }
+
+                /**
+                 * Rate limits every call site through the suppressor, null turns it off. The
+                 * suppressor is not owned and may be shared between loggers.
+                 **/
+                void SetStormSuppressor(SPIN::Log::StormSuppressor* suppressor)
+                {
+                    this->_suppressor = suppressor;
+                }
+#ifndef ARDUINO
+                /**
+                 * Turns on the per-level record counts and the truncation count of this logger and
+                 * the metrics of every sink it has. Not thread safe, enable before logging starts.
+                 **/
+                void EnableMetrics(bool enable)
+                {
+                    if (enable && this->_metrics == nullptr)
+                    {
+                        this->_metrics = (SPIN::Log::Metrics::LoggerMetrics*)malloc(sizeof(SPIN::Log::Metrics::LoggerMetrics));
+                        if (this->_metrics == nullptr)
+                        {
+                            throw std::exception();
+                        }
+                        new (this->_metrics) SPIN::Log::Metrics::LoggerMetrics();
+                    }
+                    else if (!enable)
+                    {
+                        this->DestroyMetrics();
+                    }
+
+                    static_cast<Logger*>(this)->EnableSinkMetrics(enable);
+                }
+                /**
+                 * Logs the metrics as Information records every interval microseconds, checked
+                 * whenever a record is logged. 0 stops them.
+                 **/
+                void SetMetricsInterval(uint64_t interval)
+                {
+                    if (this->_metrics != nullptr)
+                    {
+                        this->_metrics->SetInterval(interval);
+                    }
+                }
+                bool GetMetrics(SPIN::Log::Metrics::LoggerSnapshot& snapshot) const
+                {
+                    if (this->_metrics == nullptr)
+                    {
+                        return false;
+                    }
+
+                    snapshot = this->_metrics->Snapshot();
+                    return true;
+                }
+                void DestroyMetrics()
+                {
+                    if (this->_metrics != nullptr)
+                    {
+                        this->_metrics->~LoggerMetrics();
+                        free((void*)(this->_metrics));
+                    }
+                    this->_metrics = nullptr;
+                }
+#endif
+
+                /**
+                 * Logs the repeat counts of call sites that went quiet while suppressed, Flush does this first.
+                 **/
+                void ReportSuppressed()
+                {
+                    if (this->_suppressor == nullptr)
+                    {
+                        return;
+                    }
+
+                    SPIN::Log::StormSuppressor::Summary summaries[8];
+                    std::size_t count;
+                    while ((count = this->_suppressor->Collect(summaries, 8)) > 0)
+                    {
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            SPIN::Log::LogRecord record = MakeRecord(summaries[i].location, summaries[i].level, summaries[i].format);
+                            this->LogRepeats(record, summaries[i].format, summaries[i].repeats);
+                        }
+                    }
+                }
+        };
+    }
+}
+
+#endif
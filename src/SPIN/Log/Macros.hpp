@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__MACROS__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__MACROS__H__
+
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
+
+/**
+ * Levels compiled out expand to a dead branch, the arguments are still type checked
+ * but never evaluated, so the optimizer removes the whole call. Enabled levels test
+ * the logger's runtime threshold before the arguments are evaluated and pass the call site.
+ **/
+#define SPIN_LOG_DISABLED(logger, method, ...) do { if (false) { (logger).method(__VA_ARGS__); } } while (0)
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_VERBOSE
+    #define SPIN_LOG_VERBOSE(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Verbose)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Verbose, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_VERBOSE(logger, ...) SPIN_LOG_DISABLED(logger, Verbose, __VA_ARGS__)
+#endif
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_DEBUG
+    #define SPIN_LOG_DEBUG(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Debug)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Debug, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_DEBUG(logger, ...) SPIN_LOG_DISABLED(logger, Debug, __VA_ARGS__)
+#endif
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_INFORMATION
+    #define SPIN_LOG_INFORMATION(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Information)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Information, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_INFORMATION(logger, ...) SPIN_LOG_DISABLED(logger, Information, __VA_ARGS__)
+#endif
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_WARNING
+    #define SPIN_LOG_WARNING(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Warning)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Warning, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_WARNING(logger, ...) SPIN_LOG_DISABLED(logger, Warning, __VA_ARGS__)
+#endif
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_ERROR
+    #define SPIN_LOG_ERROR(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Error)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Error, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_ERROR(logger, ...) SPIN_LOG_DISABLED(logger, Error, __VA_ARGS__)
+#endif
+
+#if SPIN_LOG_MIN_LEVEL <= SPIN_LOG_LEVEL_FATAL
+    #define SPIN_LOG_FATAL(logger, ...) do { if ((logger).IsEnabled(SPIN::Log::LogLevel::Fatal)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, SPIN::Log::LogLevel::Fatal, __VA_ARGS__); } } while (0)
+#else
+    #define SPIN_LOG_FATAL(logger, ...) SPIN_LOG_DISABLED(logger, Fatal, __VA_ARGS__)
+#endif
+
+#define SPIN_LOG(logger, logLevel, ...) do { if (SPIN::Log::IsCompiledIn(logLevel) && (logger).IsEnabled(logLevel)) { (logger).LogAt(SPIN_LOG_SOURCE_LOCATION, logLevel, __VA_ARGS__); } } while (0)
+
+/**
+ * Typed logging: SPIN_LOG_TYPED(logger, level, "x=%d name=%s", x, name) fails to compile when an
+ * argument does not fit its conversion or the argument count is off. The format must be a literal.
+ **/
+#define SPIN_LOG_FIRST_ARGUMENT(...) SPIN_LOG_FIRST_ARGUMENT_(__VA_ARGS__, 0)
+#define SPIN_LOG_FIRST_ARGUMENT_(first, ...) first
+#define SPIN_LOG_TYPED(logger, logLevel, ...)                                                                                 \
+    do                                                                                                                        \
+    {                                                                                                                         \
+        static_assert(SPIN::Log::Format::FormatMatches(SPIN_LOG_FIRST_ARGUMENT(__VA_ARGS__),                                  \
+                                                       decltype(SPIN::Log::Format::ArgumentTypes(__VA_ARGS__))()),            \
+                      "SPIN_LOG_TYPED: arguments do not match the format string");                                           \
+        if (SPIN::Log::IsCompiledIn(logLevel) && (logger).IsEnabled(logLevel))                                                \
+        {                                                                                                                     \
+            (logger).LogTypedAt(SPIN_LOG_SOURCE_LOCATION, logLevel, __VA_ARGS__);                                             \
+        }                                                                                                                     \
+    } while (0)
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Metrics.hpp>
+
+#ifndef ARDUINO
+
+#include <cstring>
+
+#include <SPIN/Log/Thread.hpp>
+
+
+namespace
+{
+    std::size_t ShardIndex()
+    {
+        return (std::size_t)(SPIN::Log::Thread::CurrentId()) & (SPIN::Log::Metrics::Shards - 1);
+    }
+
+    std::size_t BucketOf(uint64_t nanoseconds)
+    {
+        std::size_t bucket = (nanoseconds == 0) ? 0 : (std::size_t)(63 - __builtin_clzll(nanoseconds));
+
+        return (bucket < SPIN::Log::Metrics::HistogramBuckets) ? bucket : SPIN::Log::Metrics::HistogramBuckets - 1;
+    }
+}
+
+
+
+uint64_t SPIN::Log::Metrics::HistogramSnapshot::Percentile(double fraction) const
+{
+    if (this->count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(fraction * (double)(this->count));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+    {
+        seen += this->buckets[i];
+        if (seen > rank)
+        {
+            uint64_t upper = ((uint64_t)2 << i) - 1;
+            return (upper < this->maximum) ? upper : this->maximum;
+        }
+    }
+
+    return this->maximum;
+}
+uint64_t SPIN::Log::Metrics::HistogramSnapshot::Mean() const
+{
+    return (this->count == 0) ? 0 : this->total / this->count;
+}
+
+
+SPIN::Log::Metrics::Histogram::Histogram()
+{
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+    {
+        this->_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    this->_total.store(0, std::memory_order_relaxed);
+    this->_maximum.store(0, std::memory_order_relaxed);
+}
+
+void SPIN::Log::Metrics::Histogram::Add(uint64_t nanoseconds)
+{
+    this->_buckets[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    this->_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t maximum = this->_maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > maximum && !this->_maximum.compare_exchange_weak(maximum, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+void SPIN::Log::Metrics::Histogram::AddTo(SPIN::Log::Metrics::HistogramSnapshot& snapshot) const
+{
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+    {
+        uint64_t count = this->_buckets[i].load(std::memory_order_relaxed);
+        snapshot.buckets[i] += count;
+        snapshot.count += count;
+    }
+    snapshot.total += this->_total.load(std::memory_order_relaxed);
+
+    uint64_t maximum = this->_maximum.load(std::memory_order_relaxed);
+    if (maximum > snapshot.maximum)
+    {
+        snapshot.maximum = maximum;
+    }
+}
+
+
+SPIN::Log::Metrics::LoggerMetrics::LoggerMetrics()
+{
+    for (std::size_t i = 0; i < Shards; i++)
+    {
+        for (std::size_t j = 0; j < 6; j++)
+        {
+            this->_shards[i].records[j].store(0, std::memory_order_relaxed);
+        }
+        this->_shards[i].truncated.store(0, std::memory_order_relaxed);
+    }
+}
+
+void SPIN::Log::Metrics::LoggerMetrics::CountRecord(SPIN::Log::LogLevel logLevel)
+{
+    this->_shards[ShardIndex()].records[(uint8_t)logLevel].fetch_add(1, std::memory_order_relaxed);
+}
+void SPIN::Log::Metrics::LoggerMetrics::CountTruncated()
+{
+    this->_shards[ShardIndex()].truncated.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SPIN::Log::Metrics::LoggerMetrics::SetInterval(uint64_t interval)
+{
+    this->_interval = interval;
+    this->_nextReport.store(0, std::memory_order_relaxed);
+}
+bool SPIN::Log::Metrics::LoggerMetrics::ReportDue(uint64_t now)
+{
+    if (this->_interval == 0)
+    {
+        return false;
+    }
+
+    uint64_t next = this->_nextReport.load(std::memory_order_relaxed);
+    if (next == 0)
+    {
+        // The first record only starts the clock.
+        this->_nextReport.compare_exchange_strong(next, now + this->_interval, std::memory_order_relaxed);
+        return false;
+    }
+
+    return now >= next && this->_nextReport.compare_exchange_strong(next, now + this->_interval, std::memory_order_relaxed);
+}
+
+SPIN::Log::Metrics::LoggerSnapshot SPIN::Log::Metrics::LoggerMetrics::Snapshot() const
+{
+    SPIN::Log::Metrics::LoggerSnapshot snapshot;
+    memset((void*)&snapshot, 0, sizeof(snapshot));
+
+    for (std::size_t i = 0; i < Shards; i++)
+    {
+        for (std::size_t j = 0; j < 6; j++)
+        {
+            snapshot.records[j] += this->_shards[i].records[j].load(std::memory_order_relaxed);
+        }
+        snapshot.truncated += this->_shards[i].truncated.load(std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+
+SPIN::Log::Metrics::SinkMetrics::SinkMetrics()
+{
+    for (std::size_t i = 0; i < Shards; i++)
+    {
+        this->_shards[i].records.store(0, std::memory_order_relaxed);
+        this->_shards[i].bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+void SPIN::Log::Metrics::SinkMetrics::CountHandle(uint64_t records, uint64_t bytes, uint64_t nanoseconds)
+{
+    Shard& shard = this->_shards[ShardIndex()];
+    shard.records.fetch_add(records, std::memory_order_relaxed);
+    shard.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    shard.handle.Add(nanoseconds);
+}
+void SPIN::Log::Metrics::SinkMetrics::CountFlush(uint64_t nanoseconds)
+{
+    this->_shards[ShardIndex()].flush.Add(nanoseconds);
+}
+
+SPIN::Log::Metrics::SinkSnapshot SPIN::Log::Metrics::SinkMetrics::Snapshot() const
+{
+    SPIN::Log::Metrics::SinkSnapshot snapshot;
+    memset((void*)&snapshot, 0, sizeof(snapshot));
+
+    for (std::size_t i = 0; i < Shards; i++)
+    {
+        snapshot.records += this->_shards[i].records.load(std::memory_order_relaxed);
+        snapshot.bytes += this->_shards[i].bytes.load(std::memory_order_relaxed);
+        this->_shards[i].handle.AddTo(snapshot.handle);
+        this->_shards[i].flush.AddTo(snapshot.flush);
+    }
+
+    return snapshot;
+}
+
+#endif
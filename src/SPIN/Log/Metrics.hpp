@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__METRICS__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__METRICS__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Metrics
+        {
+            /** Bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the last one everything longer. **/
+            static constexpr std::size_t HistogramBuckets = 32;
+            /** Threads update the shard of their id, so counters rarely share a cache line. **/
+            static constexpr std::size_t Shards = 16;
+
+            struct HistogramSnapshot
+            {
+                uint64_t buckets[HistogramBuckets];
+                uint64_t count;
+                uint64_t total;
+                uint64_t maximum;
+
+                /** Upper bound of the bucket holding the given fraction (0.5, 0.99...) of the samples. **/
+                uint64_t Percentile(double) const;
+                uint64_t Mean() const;
+            };
+
+            struct LoggerSnapshot
+            {
+                uint64_t records[6];
+                uint64_t truncated;
+            };
+
+            struct SinkSnapshot
+            {
+                uint64_t records;
+                uint64_t bytes;
+                SPIN::Log::Metrics::HistogramSnapshot handle;
+                SPIN::Log::Metrics::HistogramSnapshot flush;
+            };
+
+            class Histogram
+            {
+                private:
+                    std::atomic<uint64_t> _buckets[HistogramBuckets];
+                    std::atomic<uint64_t> _total;
+                    std::atomic<uint64_t> _maximum;
+
+                public:
+                    Histogram();
+                    Histogram(const Histogram&) = delete;
+
+                    void Add(uint64_t);
+                    void AddTo(SPIN::Log::Metrics::HistogramSnapshot&) const;
+
+                    Histogram& operator=(const Histogram&) = delete;
+            };
+
+            /**
+             * Records per level and truncated renders of one logger.
+             **/
+            class LoggerMetrics
+            {
+                private:
+                    struct Shard
+                    {
+                        std::atomic<uint64_t> records[6];
+                        std::atomic<uint64_t> truncated;
+                        char padding[64];
+                    };
+
+                    Shard _shards[Shards];
+                    uint64_t _interval = 0;
+                    std::atomic<uint64_t> _nextReport{ 0 };
+
+                public:
+                    LoggerMetrics();
+                    LoggerMetrics(const LoggerMetrics&) = delete;
+
+                    void CountRecord(SPIN::Log::LogLevel);
+                    void CountTruncated();
+
+                    /** Microseconds between metrics records, 0 turns them off. **/
+                    void SetInterval(uint64_t);
+                    /** True for exactly one caller once the interval has passed. **/
+                    bool ReportDue(uint64_t);
+
+                    SPIN::Log::Metrics::LoggerSnapshot Snapshot() const;
+
+                    LoggerMetrics& operator=(const LoggerMetrics&) = delete;
+            };
+
+            /**
+             * Records and bytes handed to one sink and how long its Handle and Flush calls took.
+             **/
+            class SinkMetrics
+            {
+                private:
+                    struct Shard
+                    {
+                        std::atomic<uint64_t> records;
+                        std::atomic<uint64_t> bytes;
+                        SPIN::Log::Metrics::Histogram handle;
+                        SPIN::Log::Metrics::Histogram flush;
+                        char padding[64];
+                    };
+
+                    Shard _shards[Shards];
+
+                public:
+                    SinkMetrics();
+                    SinkMetrics(const SinkMetrics&) = delete;
+
+                    void CountHandle(uint64_t records, uint64_t bytes, uint64_t nanoseconds);
+                    void CountFlush(uint64_t nanoseconds);
+
+                    SPIN::Log::Metrics::SinkSnapshot Snapshot() const;
+
+                    SinkMetrics& operator=(const SinkMetrics&) = delete;
+            };
+        }
+    }
+}
+
+#endif
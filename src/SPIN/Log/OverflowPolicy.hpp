@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__OVERFLOWPOLICY__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__OVERFLOWPOLICY__H__
+
+#include <stdint.h>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        /**
+         * What a producer does when the queue of a buffered logger is full. Every record that is
+         * lost is counted at its own level. Threads marked with Thread::SetRealTime never wait,
+         * where a policy would wait they drop instead.
+         **/
+        enum class OverflowPolicy : uint8_t
+        {
+            // The new record is dropped.
+            DropNewest = 0,
+            // The producer yields until the worker made room.
+            Block = 1,
+            // The oldest queued record is taken out and dropped to make room.
+            OverwriteOldest = 2,
+            // Levels below Error may not use the last quarter of the queue, Error and Fatal wait for room.
+            PreserveErrors = 3
+        };
+    }
+}
+
+#endif
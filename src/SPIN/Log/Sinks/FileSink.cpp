@@ -32,11 +32,35 @@
 #ifdef ARDUINO
     #include <Arduino.h>
     #include <stdint.h>
+    #include <stdlib.h>
+    #include <string.h>
 #else
     #include <ostream>
+    #include <cerrno>
+    #include <chrono>
+    #include <condition_variable>
     #include <cstdint>
+    #include <cstdlib>
+    #include <cstring>
+    #include <mutex>
+    #include <new>
+    #include <thread>
 #endif
 
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+    #define __LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#include <SPIN/Log/Clock.hpp>
+#include <SPIN/Log/Format/ArgumentCodec.hpp>
+#include <SPIN/Log/Format/TimestampPrefix.hpp>
+#include <SPIN/Log/Format/Varint.hpp>
+
 static const char tags[6][7] = {
     "[VER]:",
     "[DEB]:",
@@ -46,151 +70,1462 @@ static const char tags[6][7] = {
     "[FAT]:"
 };
 
+/**
+ * Binary layout: "SPLG", version, flags, varint base timestamp, then entries that start with
+ * a kind byte. Dictionary entries carry a format string once per file, records reference it
+ * by id and carry zigzag timestamp deltas (microseconds) and the encoded arguments.
+ **/
+static const uint8_t binaryMagic[4] = { 'S', 'P', 'L', 'G' };
+static const uint8_t binaryVersion = 1;
+static const uint8_t binaryDictionaryEntry = 0x01;
+static const uint8_t binaryFormattedRecord = 0x10;
+static const uint8_t binaryTextRecord = 0x20;
+
+static const std::size_t writeAlignment = 4096;
+static const std::size_t mappingChunkSize = 1024 * 1024;
+// After the next file could not be opened, rotation is retried this many microseconds later.
+static const uint64_t nextFileRetryInterval = 1000000;
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+static bool SyncData(int fd)
+{
+#if defined(__APPLE__)
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+#endif
+#ifndef ARDUINO
+/**
+ * Everything the commit thread touches lives here on the heap, so the sink can move while the
+ * thread runs. Waiters hand their records to the kernel themselves, the thread only syncs.
+ **/
+struct SPIN::Log::Sinks::FileSink::GroupCommit
+{
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable served;
+    std::thread worker;
+    bool running = false;
+    uint64_t window = 0;
+    // Descriptor of the file being written, and rotated out files whose tail is not synced yet.
+    int fd = -1;
+    int* retired = nullptr;
+    std::size_t retiredCount = 0;
+    std::size_t retiredCapacity = 0;
+    // Record counts: the highest one a waiter asked for, one handed to the kernel, one a commit was attempted for, one on disk.
+    uint64_t requested = 0;
+    uint64_t flushed = 0;
+    uint64_t attempted = 0;
+    uint64_t persisted = 0;
+    uint64_t lastCommit = 0;
+    uint64_t commits = 0;
+    uint64_t records = 0;
+    uint64_t waits = 0;
+    uint64_t failures = 0;
+    SPIN::Log::Metrics::Histogram sync;
+    SPIN::Log::Metrics::Histogram wait;
+
+    // Called with the mutex held.
+    void Start()
+    {
+        if (!this->worker.joinable())
+        {
+            this->running = true;
+            this->worker = std::thread(&GroupCommit::Run, this);
+        }
+    }
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running = false;
+            this->wakeUp.notify_one();
+        }
+        if (this->worker.joinable())
+        {
+            this->worker.join();
+        }
+    }
+    /** Makes fd the file being written, the previous one is queued for the commit thread. **/
+    void Attach(int fd)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->fd >= 0)
+        {
+            if (this->retiredCount == this->retiredCapacity)
+            {
+                std::size_t capacity = (this->retiredCapacity == 0) ? 4 : 2 * this->retiredCapacity;
+                int* retired = (int*)realloc((void*)(this->retired), capacity * sizeof(int));
+                if (retired == nullptr)
+                {
+                    throw std::exception();
+                }
+                this->retired = retired;
+                this->retiredCapacity = capacity;
+            }
+            this->retired[this->retiredCount++] = this->fd;
+            this->Start();
+            this->wakeUp.notify_one();
+        }
+        this->fd = fd;
+    }
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (this->running)
+        {
+            if (this->requested <= this->attempted && this->retiredCount == 0)
+            {
+                this->wakeUp.wait(lock);
+                continue;
+            }
+
+            // Commits are spaced a window apart, waiters arriving meanwhile share the next one.
+            if (this->requested > this->attempted && this->window != 0)
+            {
+                uint64_t now = SPIN::Log::Clock::Microseconds();
+                if (now < this->lastCommit + this->window)
+                {
+                    this->wakeUp.wait_for(lock, std::chrono::microseconds(this->lastCommit + this->window - now), [this]() {
+                        return !this->running;
+                    });
+                }
+            }
+
+            uint64_t target = this->flushed;
+            int fd = this->fd;
+            // A few rotated out files per commit, the rest wait for the next round.
+            int stackRetired[4];
+            std::size_t retiredCount = (this->retiredCount < 4) ? this->retiredCount : 4;
+            if (retiredCount != 0)
+            {
+                memcpy((void*)stackRetired, (const void*)(this->retired), retiredCount * sizeof(int));
+                memmove((void*)(this->retired), (const void*)(this->retired + retiredCount), (this->retiredCount - retiredCount) * sizeof(int));
+                this->retiredCount -= retiredCount;
+            }
+            this->lastCommit = SPIN::Log::Clock::Microseconds();
+            lock.unlock();
+
+            // Only Run closes descriptors while it is running, so fd stays valid outside the lock.
+            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+            bool synced = true;
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+            for (std::size_t i = 0; i < retiredCount; i++)
+            {
+                synced = SyncData(stackRetired[i]) && synced;
+                close(stackRetired[i]);
+            }
+            synced = (fd < 0 || SyncData(fd)) && synced;
+#else
+            (void)fd;
+#endif
+            uint64_t elapsed = SPIN::Log::Clock::Nanoseconds() - start;
+
+            lock.lock();
+            this->sync.Add(elapsed);
+            this->commits++;
+            if (synced && target > this->persisted)
+            {
+                this->records += target - this->persisted;
+                this->persisted = target;
+            }
+            else if (!synced)
+            {
+                this->failures++;
+            }
+            this->attempted = (target > this->attempted) ? target : this->attempted;
+            this->served.notify_all();
+        }
+    }
+
+    ~GroupCommit()
+    {
+        this->Stop();
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+        for (std::size_t i = 0; i < this->retiredCount; i++)
+        {
+            SyncData(this->retired[i]);
+            close(this->retired[i]);
+        }
+        if (this->fd >= 0)
+        {
+            close(this->fd);
+        }
+#endif
+        if (this->retired != nullptr)
+        {
+            free((void*)(this->retired));
+        }
+    }
+};
+/**
+ * Closes rotated out files on one long lived thread, started by the first rotation. Like
+ * GroupCommit it lives on the heap and never touches the sink.
+ **/
+struct SPIN::Log::Sinks::FileSink::FileCloser
+{
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::thread worker;
+    bool running = false;
+    FILE** pending = nullptr;
+    std::size_t pendingCount = 0;
+    std::size_t pendingCapacity = 0;
+
+    void Close(FILE* fptr)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->pendingCount == this->pendingCapacity)
+        {
+            std::size_t capacity = (this->pendingCapacity == 0) ? 2 : 2 * this->pendingCapacity;
+            FILE** pending = (FILE**)realloc((void*)(this->pending), capacity * sizeof(FILE*));
+            if (pending == nullptr)
+            {
+                fclose(fptr);
+                return;
+            }
+            this->pending = pending;
+            this->pendingCapacity = capacity;
+        }
+        this->pending[this->pendingCount++] = fptr;
+
+        if (!this->worker.joinable())
+        {
+            this->running = true;
+            this->worker = std::thread(&FileCloser::Run, this);
+        }
+        this->wakeUp.notify_one();
+    }
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (this->running)
+        {
+            if (this->pendingCount == 0)
+            {
+                this->wakeUp.wait(lock);
+                continue;
+            }
+
+            FILE* fptr = this->pending[--this->pendingCount];
+            lock.unlock();
+            fclose(fptr);
+            lock.lock();
+        }
+    }
+
+    ~FileCloser()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running = false;
+            this->wakeUp.notify_one();
+        }
+        if (this->worker.joinable())
+        {
+            this->worker.join();
+        }
+
+        for (std::size_t i = 0; i < this->pendingCount; i++)
+        {
+            fclose(this->pending[i]);
+        }
+        if (this->pending != nullptr)
+        {
+            free((void*)(this->pending));
+        }
+    }
+};
+#endif
+
+
+/**
+ * Matches a directory entry against the file name format and extracts the counter it was
+ * written with. Every conversion in the format receives the same counter.
+ **/
+static bool MatchFileName(const char* fmt, const char* name, uint32_t& counter)
+{
+    bool matched = false;
+
+    while (*fmt != '\0')
+    {
+        if (*fmt != '%')
+        {
+            if (*fmt++ != *name++)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        fmt++;
+        if (*fmt == '%')
+        {
+            if (*name++ != '%')
+            {
+                return false;
+            }
+            fmt++;
+            continue;
+        }
+
+        while (*fmt != '\0' && strchr("-+ #0123456789.hlLqjzt", *fmt) != nullptr)
+        {
+            fmt++;
+        }
+
+        uint32_t base = (*fmt == 'x' || *fmt == 'X') ? 16 : (*fmt == 'o' ? 8 : 10);
+        if (*fmt != '\0')
+        {
+            fmt++;
+        }
+
+        uint64_t value = 0;
+        const char* digits = name;
+        while (true)
+        {
+            uint32_t digit;
+            if (*name >= '0' && *name <= '9')
+            {
+                digit = (uint32_t)(*name - '0');
+            }
+            else if (base == 16 && *name >= 'a' && *name <= 'f')
+            {
+                digit = (uint32_t)(*name - 'a' + 10);
+            }
+            else if (base == 16 && *name >= 'A' && *name <= 'F')
+            {
+                digit = (uint32_t)(*name - 'A' + 10);
+            }
+            else
+            {
+                break;
+            }
+
+            if (digit >= base || value > 0xFFFFFFFFu)
+            {
+                return false;
+            }
+            value = value * base + digit;
+            name++;
+        }
+
+        if (name == digits || value > 0xFFFFFFFFu || (matched && (uint32_t)value != counter))
+        {
+            return false;
+        }
+
+        counter = (uint32_t)value;
+        matched = true;
+    }
+
+    return matched && *name == '\0';
+}
+
+
+SPIN::Log::Sinks::FileSink::FileSink(char* fmt)
+{
+    if (!this->SetFileNameFmt(fmt))
+    {
+#ifndef ARDUINO
+        throw std::exception();
+#endif
+        return;
+    }
+}
+SPIN::Log::Sinks::FileSink::FileSink(const SPIN::Log::Sinks::FileSink& obj) : SPIN::Log::Sinks::ISink(obj)
+{
+    this->_binary = obj._binary;
+    this->_maximumFileSize = obj._maximumFileSize;
+    this->_rotationInterval = obj._rotationInterval;
+    this->_memoryMapped = obj._memoryMapped;
+    this->_timestamps = obj._timestamps;
+
+    if (!this->SetFileNameFmt(obj._fileNameFmt) || !this->SetWriteBufferSize(obj._writeBufferSize))
+    {
+#ifndef ARDUINO
+        throw std::exception();
+#endif
+        return;
+    }
+#ifndef ARDUINO
+    if (obj._durable)
+    {
+        this->EnableGroupCommit(obj._commitWindow);
+    }
+#endif
+}
+SPIN::Log::Sinks::FileSink::FileSink(SPIN::Log::Sinks::FileSink&& deadObj) noexcept : SPIN::Log::Sinks::ISink(deadObj)
+{
+    this->_fileNameFmt = deadObj._fileNameFmt;
+    this->_fileNameFmtSize = deadObj._fileNameFmtSize;
+    this->_fileName = deadObj._fileName;
+    this->_fileNameSize = deadObj._fileNameSize;
+    this->_counter = deadObj._counter;
+    this->_counterScanned = deadObj._counterScanned;
+    this->_fileOpen = deadObj._fileOpen;
+    this->_fptr = deadObj._fptr;
+    this->_binary = deadObj._binary;
+    this->_dictionary = deadObj._dictionary;
+    this->_dictionaryCapacity = deadObj._dictionaryCapacity;
+    this->_dictionarySize = deadObj._dictionarySize;
+    this->_lastTimestamp = deadObj._lastTimestamp;
+    this->_scratch = deadObj._scratch;
+    this->_scratchSize = deadObj._scratchSize;
+    this->_writeBuffer = deadObj._writeBuffer;
+    this->_writeBufferSize = deadObj._writeBufferSize;
+    this->_writeBufferUsed = deadObj._writeBufferUsed;
+    this->_maximumFileSize = deadObj._maximumFileSize;
+    this->_rotationInterval = deadObj._rotationInterval;
+    this->_fileBytes = deadObj._fileBytes;
+    this->_fileOpenedAt = deadObj._fileOpenedAt;
+    this->_memoryMapped = deadObj._memoryMapped;
+    this->_timestamps = deadObj._timestamps;
+#ifndef ARDUINO
+    this->_mapping = deadObj._mapping;
+    this->_mappingSize = deadObj._mappingSize;
+    this->_mappingUsed = deadObj._mappingUsed;
+
+    deadObj._mapping = nullptr;
+    deadObj._mappingSize = 0;
+    deadObj._mappingUsed = 0;
+
+    this->TakeRotation(deadObj);
+    this->TakeGroupCommit(deadObj);
+#endif
+
+    deadObj._fileNameFmt = nullptr;
+    deadObj._fileName = nullptr;
+    deadObj._fileOpen = false;
+    deadObj._dictionary = nullptr;
+    deadObj._dictionaryCapacity = 0;
+    deadObj._scratch = nullptr;
+    deadObj._scratchSize = 0;
+    deadObj._writeBuffer = nullptr;
+    deadObj._writeBufferSize = 0;
+    deadObj._writeBufferUsed = 0;
+}
+
+
+bool SPIN::Log::Sinks::FileSink::SetFileNameFmt(char* fmt)
+{
+    std::size_t fmtSize = strlen(fmt);
+    this->_fileNameFmt = (char*)malloc((fmtSize + 1) * sizeof(char));
+    if (this->_fileNameFmt == nullptr)
+    {
+        return false;
+    }
+    this->_fileNameFmtSize = fmtSize;
+
+    memcpy((void*)(this->_fileNameFmt), (const void*)fmt, (fmtSize + 1) * sizeof(char));
+
+    return true;
+}
+bool SPIN::Log::Sinks::FileSink::SetWriteBufferSize(std::size_t size)
+{
+    if (size >= writeAlignment)
+    {
+        size = (size + writeAlignment - 1) / writeAlignment * writeAlignment;
+    }
+
+    if (size == 0)
+    {
+        if (this->_writeBuffer != nullptr)
+        {
+            free((void*)(this->_writeBuffer));
+        }
+        this->_writeBuffer = nullptr;
+        this->_writeBufferSize = 0;
+        this->_writeBufferUsed = 0;
+        return true;
+    }
+
+    auto* buffer = (char*)realloc((void*)(this->_writeBuffer), size);
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+    this->_writeBuffer = buffer;
+    this->_writeBufferSize = size;
+    this->_writeBufferUsed = 0;
+
+    return true;
+}
+void SPIN::Log::Sinks::FileSink::ScanExistingFiles()
+{
+    const char* separator = strrchr(this->_fileNameFmt, '/');
+    const char* pattern = separator == nullptr ? this->_fileNameFmt : separator + 1;
+    std::size_t directorySize = separator == nullptr ? 0 : (std::size_t)(separator - this->_fileNameFmt);
+
+    // Only a literal directory can be listed, a formatted one falls back to probing.
+    if (memchr(this->_fileNameFmt, '%', directorySize) != nullptr)
+    {
+        return;
+    }
+
+    char* directory = (char*)malloc(directorySize + 2);
+    if (directory == nullptr)
+    {
+        return;
+    }
+
+    if (separator == nullptr)
+    {
+#ifdef ARDUINO
+        directory[0] = '/';
+#else
+        directory[0] = '.';
+#endif
+        directory[1] = '\0';
+    }
+    else
+    {
+        memcpy((void*)directory, (const void*)(this->_fileNameFmt), directorySize);
+        directory[directorySize] = '\0';
+        if (directorySize == 0)
+        {
+            directory[0] = '/';
+            directory[1] = '\0';
+        }
+    }
+
+    uint32_t next = this->_counter;
+    uint32_t counter = 0;
+
+#if defined(ARDUINO)
+    File root = SD.open(directory);
+    if (root)
+    {
+        for (File entry = root.openNextFile(); entry; entry = root.openNextFile())
+        {
+            if (MatchFileName(pattern, entry.name(), counter) && counter >= next && counter != 0xFFFFFFFFu)
+            {
+                next = counter + 1;
+            }
+            entry.close();
+        }
+        root.close();
+    }
+#elif defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    DIR* root = opendir(directory);
+    if (root != nullptr)
+    {
+        for (struct dirent* entry = readdir(root); entry != nullptr; entry = readdir(root))
+        {
+            if (MatchFileName(pattern, entry->d_name, counter) && counter >= next && counter != 0xFFFFFFFFu)
+            {
+                next = counter + 1;
+            }
+        }
+        closedir(root);
+    }
+#endif
+
+    free((void*)directory);
+
+    this->_counter = next;
+}
+bool SPIN::Log::Sinks::FileSink::FindNextFileName(char* fileName)
+{
+    // One directory listing replaces probing every index that is already taken.
+    if (!this->_counterScanned)
+    {
+        this->ScanExistingFiles();
+        this->_counterScanned = true;
+    }
+
+    bool fileFound;
+    do
+    {
+        snprintf(fileName,
+                 this->_fileNameSize + 1,
+                 this->_fileNameFmt,
+                 this->_counter,
+                 this->_counter,
+                 this->_counter,
+                 this->_counter);
+
+        this->_counter++;
+
+#ifdef ARDUINO
+        fileFound = SD.exists(fileName);
+#else
+        FILE* fptr;
+        fileFound = (fptr = fopen(fileName, "r")) != NULL;
+
+        if (fileFound)
+        {
+            fclose(fptr);
+        }
+#endif
+    } while (fileFound);
+
+    return true;
+}
+bool SPIN::Log::Sinks::FileSink::OpenNextFile()
+{
+    if (this->_fileNameFmt == nullptr)
+    {
+        return false;
+    }
+
+    if (this->_fileName == nullptr)
+    {
+        std::size_t fileNameSize = this->_fileNameFmtSize + 4 * 10;
+
+        this->_fileName = (char*)malloc((fileNameSize + 1) * sizeof(char));
+        if (this->_fileName == nullptr)
+        {
+#ifndef ARDUINO
+            throw std::exception();
+#endif
+            return false;
+        }
+        this->_fileNameSize = fileNameSize;
+    }
+
+    this->CloseFile();
+
+    if (!this->FindNextFileName(this->_fileName))
+    {
+        return false;
+    }
+
+#ifdef ARDUINO
+    this->_fptr = SD.open(this->_fileName, FILE_WRITE);
+    if (!this->_fptr)
+    {
+        return false;
+    }
+#else
+    this->_fptr = fopen(this->_fileName, this->_memoryMapped ? "w+" : "w");
+    if (this->_fptr == nullptr)
+    {
+        return false;
+    }
+
+    if (this->_writeBuffer != nullptr)
+    {
+        setvbuf(this->_fptr, nullptr, _IONBF, 0);
+    }
+#endif
+
+    return this->StartFile();
+}
+bool SPIN::Log::Sinks::FileSink::StartFile()
+{
+    this->_fileOpen = true;
+    this->_fileBytes = 0;
+    this->_fileOpenedAt = SPIN::Log::Clock::Microseconds();
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    if (this->_memoryMapped && !this->MapFile(this->InitialMappingSize()))
+    {
+        return false;
+    }
+#endif
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    if (this->_groupCommit != nullptr)
+    {
+        this->_groupCommit->Attach(dup(fileno(this->_fptr)));
+    }
+#endif
+
+    if (this->_binary)
+    {
+        return this->WriteHeader();
+    }
+
+    return true;
+}
+void SPIN::Log::Sinks::FileSink::CloseFile()
+{
+    if (!this->_fileOpen)
+    {
+        return;
+    }
+
+    this->FlushWriteBuffer();
+
+#ifdef ARDUINO
+    this->_fptr.close();
+#else
+    this->UnmapFile();
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    if (this->_durable)
+    {
+        fflush(this->_fptr);
+        SyncData(fileno(this->_fptr));
+    }
+#endif
+    fclose(this->_fptr);
+#endif
+    this->_fileOpen = false;
+}
+void SPIN::Log::Sinks::FileSink::Release()
+{
+#ifndef ARDUINO
+    this->DiscardRotation();
+    this->DisableGroupCommit();
+#endif
+    this->CloseFile();
+
+    if (this->_fileNameFmt != nullptr)
+    {
+        free((void*)(this->_fileNameFmt));
+    }
+    this->_fileNameFmt = nullptr;
+    this->_fileNameFmtSize = 0;
+
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+    }
+    this->_fileName = nullptr;
+    this->_fileNameSize = 0;
+
+    if (this->_dictionary != nullptr)
+    {
+        free((void*)(this->_dictionary));
+    }
+    this->_dictionary = nullptr;
+    this->_dictionaryCapacity = 0;
+    this->_dictionarySize = 0;
+
+    if (this->_scratch != nullptr)
+    {
+        free((void*)(this->_scratch));
+    }
+    this->_scratch = nullptr;
+    this->_scratchSize = 0;
+
+    if (this->_writeBuffer != nullptr)
+    {
+        free((void*)(this->_writeBuffer));
+    }
+    this->_writeBuffer = nullptr;
+    this->_writeBufferSize = 0;
+    this->_writeBufferUsed = 0;
+
+    this->_counter = 0;
+    this->_counterScanned = false;
+}
+
+
+bool SPIN::Log::Sinks::FileSink::ShouldRotate() const
+{
+    if (this->_maximumFileSize != 0 && this->_fileBytes >= this->_maximumFileSize)
+    {
+        return true;
+    }
+
+    return this->_rotationInterval != 0 && SPIN::Log::Clock::Microseconds() - this->_fileOpenedAt >= this->_rotationInterval;
+}
+bool SPIN::Log::Sinks::FileSink::EnsureFileReady()
+{
+    if (!this->_fileOpen)
+    {
+        return this->OpenNextFile();
+    }
+
+    if (this->ShouldRotate())
+    {
+        this->RotateFile();
+    }
+
+    return true;
+}
+#ifdef ARDUINO
+bool SPIN::Log::Sinks::FileSink::RotateFile()
+{
+    return this->OpenNextFile();
+}
+#else
+void SPIN::Log::Sinks::FileSink::RetireFile(FILE* fptr)
+{
+    if (this->_fileCloser == nullptr)
+    {
+        this->_fileCloser = (FileCloser*)malloc(sizeof(FileCloser));
+        if (this->_fileCloser == nullptr)
+        {
+            fclose(fptr);
+            return;
+        }
+        new (this->_fileCloser) FileCloser();
+    }
+
+    this->_fileCloser->Close(fptr);
+}
+void SPIN::Log::Sinks::FileSink::DiscardRotation()
+{
+    if (this->_fileCloser != nullptr)
+    {
+        this->_fileCloser->~FileCloser();
+        free((void*)(this->_fileCloser));
+    }
+    this->_fileCloser = nullptr;
+
+    if (this->_nextFileName != nullptr)
+    {
+        free((void*)(this->_nextFileName));
+    }
+    this->_nextFileName = nullptr;
+    this->_nextFailedAt = 0;
+}
+void SPIN::Log::Sinks::FileSink::TakeRotation(SPIN::Log::Sinks::FileSink& deadObj)
+{
+    this->DiscardRotation();
+
+    this->_fileCloser = deadObj._fileCloser;
+    this->_nextFileName = deadObj._nextFileName;
+    this->_nextFailedAt = deadObj._nextFailedAt;
+
+    deadObj._fileCloser = nullptr;
+    deadObj._nextFileName = nullptr;
+    deadObj._nextFailedAt = 0;
+}
+bool SPIN::Log::Sinks::FileSink::RotateFile()
+{
+    // Keep writing to the current file for a while after the next one could not be opened.
+    uint64_t now = SPIN::Log::Clock::Microseconds();
+    if (this->_nextFailedAt != 0 && now - this->_nextFailedAt < nextFileRetryInterval)
+    {
+        return false;
+    }
+
+    if (this->_nextFileName == nullptr)
+    {
+        this->_nextFileName = (char*)malloc((this->_fileNameSize + 1) * sizeof(char));
+        if (this->_nextFileName == nullptr)
+        {
+            return false;
+        }
+    }
+
+    FILE* fptr = nullptr;
+    if (this->FindNextFileName(this->_nextFileName))
+    {
+        fptr = fopen(this->_nextFileName, this->_memoryMapped ? "w+" : "w");
+    }
+    if (fptr == nullptr)
+    {
+        this->_nextFailedAt = now;
+        return false;
+    }
+    this->_nextFailedAt = 0;
+
+    this->FlushWriteBuffer();
+    this->UnmapFile();
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    // StartFile hands the tail of the retired file to the commit thread.
+    if (this->_durable)
+    {
+        fflush(this->_fptr);
+    }
+#endif
+
+    this->RetireFile(this->_fptr);
+    this->_fptr = fptr;
+
+    char* fileName = this->_fileName;
+    this->_fileName = this->_nextFileName;
+    this->_nextFileName = fileName;
+
+    if (this->_writeBuffer != nullptr)
+    {
+        setvbuf(this->_fptr, nullptr, _IONBF, 0);
+    }
+
+    return this->StartFile();
+}
+void SPIN::Log::Sinks::FileSink::EnableGroupCommit(uint64_t window)
+{
+    this->_durable = true;
+    this->_commitWindow = window;
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    if (this->_groupCommit != nullptr)
+    {
+        return;
+    }
+
+    this->_groupCommit = (GroupCommit*)malloc(sizeof(GroupCommit));
+    if (this->_groupCommit == nullptr)
+    {
+        throw std::exception();
+    }
+    new (this->_groupCommit) GroupCommit();
+    this->_groupCommit->window = window;
+    if (this->_fileOpen)
+    {
+        this->_groupCommit->Attach(dup(fileno(this->_fptr)));
+    }
+
+    // Deliveries now take the flush lock, so waiters can flush between them.
+    this->_externalFlush = true;
+#endif
+}
+void SPIN::Log::Sinks::FileSink::DisableGroupCommit()
+{
+    GroupCommit* commit = this->_groupCommit;
+    if (commit == nullptr)
+    {
+        return;
+    }
+
+    commit->~GroupCommit();
+    free((void*)commit);
+    this->_groupCommit = nullptr;
+    this->_externalFlush = false;
+}
+void SPIN::Log::Sinks::FileSink::TakeGroupCommit(SPIN::Log::Sinks::FileSink& deadObj)
+{
+    this->DisableGroupCommit();
+
+    this->_durable = deadObj._durable;
+    this->_commitWindow = deadObj._commitWindow;
+    this->_written.store(deadObj._written.load());
+    this->_groupCommit = deadObj._groupCommit;
+    this->_externalFlush = deadObj._externalFlush;
+    deadObj._externalFlush = false;
+
+    deadObj._groupCommit = nullptr;
+}
+#endif
+
+
+bool SPIN::Log::Sinks::FileSink::WriteThrough(const void* head, std::size_t headLength, const void* tail, std::size_t tailLength)
+{
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    int fd = fileno(this->_fptr);
+    struct iovec vectors[2] = {
+        { (void*)head, headLength },
+        { (void*)tail, tailLength }
+    };
+    struct iovec* vector = vectors;
+    int count = (tailLength == 0) ? 1 : 2;
+
+    while (count > 0)
+    {
+        ssize_t written = writev(fd, vector, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+
+        while (count > 0 && (std::size_t)written >= vector->iov_len)
+        {
+            written -= (ssize_t)(vector->iov_len);
+            vector++;
+            count--;
+        }
+        if (count > 0)
+        {
+            vector->iov_base = (void*)((char*)(vector->iov_base) + written);
+            vector->iov_len -= (std::size_t)written;
+        }
+    }
+
+    return true;
+#elif defined(ARDUINO)
+    return this->_fptr.write((const uint8_t*)head, headLength) == headLength
+           && (tailLength == 0 || this->_fptr.write((const uint8_t*)tail, tailLength) == tailLength);
+#else
+    return fwrite(head, 1, headLength, this->_fptr) == headLength
+           && (tailLength == 0 || fwrite(tail, 1, tailLength, this->_fptr) == tailLength);
+#endif
+}
+bool SPIN::Log::Sinks::FileSink::FlushWriteBuffer()
+{
+    if (this->_writeBufferUsed == 0)
+    {
+        return true;
+    }
+
+    std::size_t used = this->_writeBufferUsed;
+    this->_writeBufferUsed = 0;
+
+    return this->WriteThrough((const void*)(this->_writeBuffer), used, nullptr, 0);
+}
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+std::size_t SPIN::Log::Sinks::FileSink::InitialMappingSize() const
+{
+    std::size_t size = this->_maximumFileSize == 0 ? mappingChunkSize : this->_maximumFileSize + writeAlignment;
+
+    return (size + writeAlignment - 1) / writeAlignment * writeAlignment;
+}
+bool SPIN::Log::Sinks::FileSink::AllocateFile(int fd, std::size_t size)
+{
+#if defined(__APPLE__)
+    return ftruncate(fd, (off_t)size) == 0;
+#else
+    int result = posix_fallocate(fd, 0, (off_t)size);
+    if (result == EINVAL || result == EOPNOTSUPP)
+    {
+        return ftruncate(fd, (off_t)size) == 0;
+    }
+
+    return result == 0;
+#endif
+}
+bool SPIN::Log::Sinks::FileSink::MapFile(std::size_t size)
+{
+    int fd = fileno(this->_fptr);
+
+    if (!this->AllocateFile(fd, size))
+    {
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    this->_mapping = (char*)mapping;
+    this->_mappingSize = size;
+
+    return true;
+}
+void SPIN::Log::Sinks::FileSink::UnmapFile()
+{
+    if (this->_mapping == nullptr)
+    {
+        return;
+    }
+
+    munmap((void*)(this->_mapping), this->_mappingSize);
+    if (ftruncate(fileno(this->_fptr), (off_t)(this->_mappingUsed)) != 0)
+    {
+        this->_mappingUsed = 0;
+    }
+
+    this->_mapping = nullptr;
+    this->_mappingSize = 0;
+    this->_mappingUsed = 0;
+}
+bool SPIN::Log::Sinks::FileSink::WriteMapped(const void* data, std::size_t length)
+{
+    if (this->_mappingUsed + length > this->_mappingSize)
+    {
+        std::size_t size = this->_mappingSize == 0 ? this->InitialMappingSize() : this->_mappingSize * 2;
+        while (size < this->_mappingUsed + length)
+        {
+            size *= 2;
+        }
+
+        std::size_t used = this->_mappingUsed;
+        if (this->_mapping != nullptr)
+        {
+            munmap((void*)(this->_mapping), this->_mappingSize);
+            this->_mapping = nullptr;
+        }
+
+        if (!this->MapFile(size))
+        {
+            this->_mappingSize = 0;
+            this->_mappingUsed = 0;
+            return false;
+        }
+        this->_mappingUsed = used;
+    }
+
+    memcpy((void*)(this->_mapping + this->_mappingUsed), data, length);
+    this->_mappingUsed += length;
+
+    return true;
+}
+#elif !defined(ARDUINO)
+void SPIN::Log::Sinks::FileSink::UnmapFile()
+{
+}
+#endif
+bool SPIN::Log::Sinks::FileSink::Write(const void* data, std::size_t length)
+{
+    this->_fileBytes += length;
+
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    if (this->_memoryMapped)
+    {
+        return this->WriteMapped(data, length);
+    }
+#endif
+
+    if (this->_writeBuffer == nullptr)
+    {
+        return this->WriteThrough(data, length, nullptr, 0);
+    }
+
+    if (this->_writeBufferUsed + length < this->_writeBufferSize)
+    {
+        memcpy((void*)(this->_writeBuffer + this->_writeBufferUsed), data, length);
+        this->_writeBufferUsed += length;
+        return true;
+    }
+
+    if (length >= this->_writeBufferSize)
+    {
+        std::size_t used = this->_writeBufferUsed;
+        this->_writeBufferUsed = 0;
+
+        return this->WriteThrough((const void*)(this->_writeBuffer), used, data, length);
+    }
+
+    std::size_t head = this->_writeBufferSize - this->_writeBufferUsed;
+    memcpy((void*)(this->_writeBuffer + this->_writeBufferUsed), data, head);
+    this->_writeBufferUsed = 0;
+
+    bool written = this->WriteThrough((const void*)(this->_writeBuffer), this->_writeBufferSize, nullptr, 0);
+
+    memcpy((void*)(this->_writeBuffer), (const void*)((const char*)data + head), length - head);
+    this->_writeBufferUsed = length - head;
+
+    return written;
+}
+bool SPIN::Log::Sinks::FileSink::WriteVarint(uint64_t value)
+{
+    uint8_t encoded[SPIN::Log::Format::MaximumVarintSize];
+
+    return this->Write((const void*)encoded, SPIN::Log::Format::WriteVarint(value, encoded));
+}
+bool SPIN::Log::Sinks::FileSink::WriteHeader()
+{
+    uint8_t header[6] = { binaryMagic[0], binaryMagic[1], binaryMagic[2], binaryMagic[3], binaryVersion, 0 };
+
+    if (this->_dictionary != nullptr)
+    {
+        memset((void*)(this->_dictionary), 0, this->_dictionaryCapacity * sizeof(DictionaryEntry));
+    }
+    this->_dictionarySize = 0;
+    this->_lastTimestamp = SPIN::Log::Clock::Microseconds();
+
+    return this->Write((const void*)header, sizeof(header)) && this->WriteVarint(this->_lastTimestamp);
+}
+bool SPIN::Log::Sinks::FileSink::WriteTimestamp(uint64_t timestamp)
+{
+    int64_t delta = (int64_t)(timestamp - this->_lastTimestamp);
+    this->_lastTimestamp = timestamp;
+
+    return this->WriteVarint(SPIN::Log::Format::ZigZagEncode(delta));
+}
+bool SPIN::Log::Sinks::FileSink::LookupFormat(const char* format, uint32_t& id, bool& inserted)
+{
+    if (this->_dictionarySize * 2 >= this->_dictionaryCapacity)
+    {
+        std::size_t capacity = (this->_dictionaryCapacity == 0) ? 64 : this->_dictionaryCapacity * 2;
+        auto* dictionary = (DictionaryEntry*)calloc(capacity, sizeof(DictionaryEntry));
+        if (dictionary == nullptr)
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < this->_dictionaryCapacity; i++)
+        {
+            if (this->_dictionary[i].format == nullptr)
+            {
+                continue;
+            }
+
+            std::size_t slot = (((uintptr_t)(this->_dictionary[i].format) >> 2) * 2654435761u) & (capacity - 1);
+            while (dictionary[slot].format != nullptr)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            dictionary[slot] = this->_dictionary[i];
+        }
 
-SPIN::Log::Sinks::FileSink::FileSink(char* fmt)
+        if (this->_dictionary != nullptr)
+        {
+            free((void*)(this->_dictionary));
+        }
+        this->_dictionary = dictionary;
+        this->_dictionaryCapacity = capacity;
+    }
+
+    std::size_t slot = (((uintptr_t)format >> 2) * 2654435761u) & (this->_dictionaryCapacity - 1);
+    while (this->_dictionary[slot].format != nullptr)
+    {
+        if (this->_dictionary[slot].format == format)
+        {
+            id = this->_dictionary[slot].id;
+            inserted = false;
+            return true;
+        }
+        slot = (slot + 1) & (this->_dictionaryCapacity - 1);
+    }
+
+    this->_dictionary[slot].format = format;
+    this->_dictionary[slot].id = this->_dictionarySize++;
+    id = this->_dictionary[slot].id;
+    inserted = true;
+
+    return true;
+}
+bool SPIN::Log::Sinks::FileSink::ReserveScratch(std::size_t size)
 {
-    if (!this->SetFileNameFmt(fmt))
+    if (this->_scratchSize >= size)
     {
-#ifndef ARDUINO
-        throw std::exception();
-#endif
+        return true;
+    }
+
+    auto* scratch = (uint8_t*)realloc((void*)(this->_scratch), size);
+    if (scratch == nullptr)
+    {
+        return false;
+    }
+    this->_scratch = scratch;
+    this->_scratchSize = size;
+
+    return true;
+}
+
+
+void SPIN::Log::Sinks::FileSink::WriteRecord(SPIN::Log::LogLevel logLevel, uint64_t timestamp, const char* message, std::size_t length)
+{
+    if (this->_binary)
+    {
+        uint8_t kind = binaryTextRecord | (uint8_t)logLevel;
+
+        this->Write((const void*)&kind, 1);
+        this->WriteTimestamp(timestamp);
+        this->WriteVarint(length);
+        this->Write((const void*)message, length);
         return;
     }
+
+    if (this->_timestamps)
+    {
+        this->Write((const void*)(this->_prefix.Render(timestamp)), SPIN::Log::Format::TimestampPrefix::Length);
+    }
+    this->Write((const void*)tags[(uint8_t)logLevel], sizeof(tags[0]) - 1);
+    this->Write((const void*)" ", 1);
+    this->Write((const void*)message, length);
+#ifdef ARDUINO
+    this->Write((const void*)"\r\n", 2);
+#else
+    this->Write((const void*)"\n", 1);
+#endif
+}
+void SPIN::Log::Sinks::FileSink::PrintRecord(SPIN::Log::LogLevel logLevel, uint64_t timestamp, const char* message)
+{
+    const char* tag = tags[(uint8_t)logLevel];
+    const char* prefix = this->_timestamps ? this->_prefix.Render(timestamp) : "";
+
+#ifdef ARDUINO
+    this->_fileBytes += this->_fptr.print(prefix);
+    this->_fileBytes += this->_fptr.print(tag);
+    this->_fileBytes += this->_fptr.print(' ');
+    this->_fileBytes += this->_fptr.println(message);
+#else
+    int written = fprintf(this->_fptr, "%s%s %s\n", prefix, tag, message);
+    if (written > 0)
+    {
+        this->_fileBytes += (std::size_t)written;
+    }
+#endif
 }
-SPIN::Log::Sinks::FileSink::FileSink(const SPIN::Log::Sinks::FileSink& obj)
+void SPIN::Log::Sinks::FileSink::Handle(SPIN::Log::LogLevel logLevel, const char* message)
 {
-    if (!this->SetFileNameFmt(obj._fileNameFmt))
+    if (!this->EnsureFileReady())
     {
 #ifndef ARDUINO
         throw std::exception();
 #endif
         return;
     }
+
+    uint64_t timestamp = (this->_binary || this->_timestamps) ? SPIN::Log::Clock::Microseconds() : 0;
+
+    if (this->_binary || this->_writeBuffer != nullptr || this->_memoryMapped)
+    {
+        this->WriteRecord(logLevel, timestamp, message, strlen(message));
+    }
+    else
+    {
+        this->PrintRecord(logLevel, timestamp, message);
+    }
+    this->CountWritten(1);
 }
-SPIN::Log::Sinks::FileSink::FileSink(SPIN::Log::Sinks::FileSink&& deadObj) noexcept
+void SPIN::Log::Sinks::FileSink::Handle(const SPIN::Log::LogRecord& record)
 {
-    this->_fileNameFmt = deadObj._fileNameFmt;
-    this->_fileNameFmtSize = deadObj._fileNameFmtSize;
-    this->_fileName = deadObj._fileName;
-    this->_fileNameSize = deadObj._fileNameSize;
-    this->_counter = deadObj._counter;
-    this->_fileOpen = deadObj._fileOpen;
-    this->_fptr = deadObj._fptr;
-
-    deadObj._fileNameFmt = nullptr;
-    deadObj._fileName = nullptr;
-    deadObj._fileOpen = false;
+    this->HandleBatch(&record, 1);
 }
-
-
-bool SPIN::Log::Sinks::FileSink::SetFileNameFmt(char* fmt)
+void SPIN::Log::Sinks::FileSink::HandleBatch(const SPIN::Log::LogRecord* records, std::size_t count)
 {
-    std::size_t fmtSize = strlen(fmt);
-    this->_fileNameFmt = (char*)malloc((fmtSize + 1) * sizeof(char));
-    if (this->_fileNameFmt == nullptr)
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < count; i++)
     {
-        return false;
-    }
-    this->_fileNameFmtSize = fmtSize;
+        if (!this->Accepts(records[i].level))
+        {
+            continue;
+        }
 
-    memcpy((void*)(this->_fileNameFmt), (const void*)fmt, (fmtSize + 1) * sizeof(char));
+        if (!this->EnsureFileReady())
+        {
+            this->CountWritten(written);
+#ifndef ARDUINO
+            throw std::exception();
+#endif
+            return;
+        }
 
-    return true;
+        if (!this->_binary && this->_writeBuffer == nullptr && !this->_memoryMapped)
+        {
+            this->PrintRecord(records[i].level, records[i].timestamp, records[i].message);
+        }
+        else
+        {
+            this->WriteRecord(records[i].level, records[i].timestamp, records[i].message, records[i].length);
+        }
+        written++;
+    }
+    this->CountWritten(written);
 }
-bool SPIN::Log::Sinks::FileSink::OpenNextFile()
+bool SPIN::Log::Sinks::FileSink::HandleDeferred(SPIN::Log::LogLevel logLevel, uint64_t timestamp, const char* fmt, const uint8_t* args, std::size_t length)
 {
-    if (this->_fileNameFmt == nullptr)
+    if (!this->_binary)
     {
         return false;
     }
 
-    if (this->_fileName == nullptr)
+    if (!this->EnsureFileReady())
     {
-        std::size_t fileNameSize = this->_fileNameFmtSize + 4 * 10;
-
-        this->_fileName = (char*)malloc((fileNameSize + 1) * sizeof(char));
-        if (this->_fileName == nullptr)
-        {
 #ifndef ARDUINO
-            throw std::exception();
+        throw std::exception();
 #endif
-            return false;
-        }
-        this->_fileNameSize = fileNameSize;
+        return true;
     }
 
-    this->CloseFile();
+    // Encode first, a record that cannot be encoded goes out as rendered text instead.
+    if (!this->ReserveScratch(2 * length + 16))
+    {
+        return false;
+    }
+    std::size_t encoded = SPIN::Log::Format::EncodeArguments(fmt, args, length, this->_scratch, this->_scratchSize);
+    if (encoded == 0 && length != 0)
+    {
+        return false;
+    }
 
-    bool fileFound;
-    do
+    uint32_t id;
+    bool inserted;
+    if (!this->LookupFormat(fmt, id, inserted))
     {
-        snprintf(this->_fileName,
-                 (const std::size_t)(this->_fileName + 1),
-                 this->_fileNameFmt,
-                 this->_counter,
-                 this->_counter,
-                 this->_counter,
-                 this->_counter);
+        return false;
+    }
 
-        this->_counter++;
+    if (inserted)
+    {
+        std::size_t fmtLength = strlen(fmt);
 
-#ifdef ARDUINO
-        fileFound = SD.exists(this->_fileName);
-#else
-        FILE* fptr;
-        fileFound = (fptr = fopen(this->_fileName, "r")) != NULL;
+        this->Write((const void*)&binaryDictionaryEntry, 1);
+        this->WriteVarint(id);
+        this->WriteVarint(fmtLength);
+        this->Write((const void*)fmt, fmtLength);
+    }
 
-        if (fileFound)
-        {
-            fclose(fptr);
-        }
-#endif
-    } while (fileFound);
+    uint8_t kind = binaryFormattedRecord | (uint8_t)logLevel;
 
-#ifdef ARDUINO
-    this->_fptr = SD.open(this->_fileName, FILE_WRITE);
-#else
-    this->_fptr = fopen(this->_fileName, "w");
-#endif
-    this->_fileOpen = true;
+    this->Write((const void*)&kind, 1);
+    this->WriteTimestamp(timestamp);
+    this->WriteVarint(id);
+    this->WriteVarint(encoded);
+    this->Write((const void*)(this->_scratch), encoded);
+    this->CountWritten(1);
 
     return true;
 }
-void SPIN::Log::Sinks::FileSink::CloseFile()
+void SPIN::Log::Sinks::FileSink::CountWritten(std::size_t count)
 {
-    if (!this->_fileOpen)
-    {
-        return;
-    }
-
-#ifdef ARDUINO
-    this->_fptr.close();
+#ifndef ARDUINO
+    // Only the delivering thread writes it, under the flush lock in durable mode.
+    this->_written.store(this->_written.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
 #else
-    fclose(this->_fptr);
+    (void)count;
 #endif
 }
+#ifndef ARDUINO
+uint64_t SPIN::Log::Sinks::FileSink::GetWrittenCount() const
+{
+    return this->_written.load(std::memory_order_relaxed);
+}
+bool SPIN::Log::Sinks::FileSink::WaitPersisted(uint64_t count)
+{
+    GroupCommit* commit = this->_groupCommit;
+    if (commit == nullptr)
+    {
+        return false;
+    }
 
+    uint64_t written = this->_written.load(std::memory_order_relaxed);
+    count = (count < written) ? count : written;
 
-void SPIN::Log::Sinks::FileSink::Handle(SPIN::Log::LogLevel logLevel, const char* message)
+    uint64_t start = SPIN::Log::Clock::Nanoseconds();
+    std::unique_lock<std::mutex> lock(commit->mutex);
+    if (commit->persisted >= count)
+    {
+        return true;
+    }
+    lock.unlock();
+
+    // The records reach the kernel here, under the sink's lock, so the commit thread only syncs.
+    this->_flushLock.Lock();
+    this->FlushPending();
+    uint64_t flushed = this->_written.load(std::memory_order_relaxed);
+    this->_flushLock.Unlock();
+
+    lock.lock();
+    commit->flushed = (flushed > commit->flushed) ? flushed : commit->flushed;
+    commit->Start();
+    if (count > commit->requested)
+    {
+        commit->requested = count;
+        commit->wakeUp.notify_one();
+    }
+
+    commit->served.wait(lock, [commit, count]() {
+        return commit->attempted >= count || !commit->running;
+    });
+    commit->waits++;
+    commit->wait.Add(SPIN::Log::Clock::Nanoseconds() - start);
+
+    return commit->persisted >= count;
+}
+bool SPIN::Log::Sinks::FileSink::Sync()
 {
-    const char* tag = tags[(uint8_t)logLevel];
+    return this->WaitPersisted(this->GetWrittenCount());
+}
+SPIN::Log::Sinks::CommitStatistics SPIN::Log::Sinks::FileSink::GetCommitStatistics() const
+{
+    SPIN::Log::Sinks::CommitStatistics statistics;
+    memset((void*)&statistics, 0, sizeof(statistics));
 
-    if (!this->_fileOpen && !this->OpenNextFile())
+    GroupCommit* commit = this->_groupCommit;
+    if (commit == nullptr)
     {
-#ifndef ARDUINO
-        throw std::exception();
-#endif
-        return;
+        return statistics;
     }
 
-#ifdef ARDUINO
-    this->_fptr.print(tag);
-    this->_fptr.print(' ');
-    this->_fptr.println(message);
-#else
-    fprintf(this->_fptr, "%s %s\n", tag, message);
-#endif
+    std::lock_guard<std::mutex> lock(commit->mutex);
+    statistics.commits = commit->commits;
+    statistics.records = commit->records;
+    statistics.waits = commit->waits;
+    statistics.failures = commit->failures;
+    commit->sync.AddTo(statistics.sync);
+    commit->wait.AddTo(statistics.wait);
+
+    return statistics;
 }
+#endif
 void SPIN::Log::Sinks::FileSink::Flush()
 {
     if (!this->_fileOpen)
@@ -198,6 +1533,8 @@ void SPIN::Log::Sinks::FileSink::Flush()
         return;
     }
 
+    this->FlushWriteBuffer();
+
 #ifdef ARDUINO
     this->_fptr.flush();
 #else
@@ -208,28 +1545,94 @@ void SPIN::Log::Sinks::FileSink::Flush()
 
 SPIN::Log::Sinks::FileSink& SPIN::Log::Sinks::FileSink::operator=(const SPIN::Log::Sinks::FileSink& obj)
 {
-    if (!this->SetFileNameFmt(obj._fileNameFmt))
+    if (this == &obj)
+    {
+        return *this;
+    }
+
+    // Like a copy, the sink starts over and opens its first file on the next write.
+    this->Release();
+
+    SPIN::Log::Sinks::ISink::operator=(obj);
+    this->_binary = obj._binary;
+    this->_maximumFileSize = obj._maximumFileSize;
+    this->_rotationInterval = obj._rotationInterval;
+    this->_memoryMapped = obj._memoryMapped;
+    this->_timestamps = obj._timestamps;
+
+    if (!this->SetFileNameFmt(obj._fileNameFmt) || !this->SetWriteBufferSize(obj._writeBufferSize))
     {
 #ifndef ARDUINO
         throw std::exception();
 #endif
     }
+#ifndef ARDUINO
+    this->_durable = false;
+    if (obj._durable)
+    {
+        this->EnableGroupCommit(obj._commitWindow);
+    }
+#endif
 
     return *this;
 }
 SPIN::Log::Sinks::FileSink& SPIN::Log::Sinks::FileSink::operator=(SPIN::Log::Sinks::FileSink&& deadObj) noexcept
 {
+    if (this == &deadObj)
+    {
+        return *this;
+    }
+
+    this->Release();
+
+    SPIN::Log::Sinks::ISink::operator=(deadObj);
     this->_fileNameFmt = deadObj._fileNameFmt;
     this->_fileNameFmtSize = deadObj._fileNameFmtSize;
     this->_fileName = deadObj._fileName;
     this->_fileNameSize = deadObj._fileNameSize;
     this->_counter = deadObj._counter;
+    this->_counterScanned = deadObj._counterScanned;
     this->_fileOpen = deadObj._fileOpen;
     this->_fptr = deadObj._fptr;
+    this->_binary = deadObj._binary;
+    this->_dictionary = deadObj._dictionary;
+    this->_dictionaryCapacity = deadObj._dictionaryCapacity;
+    this->_dictionarySize = deadObj._dictionarySize;
+    this->_lastTimestamp = deadObj._lastTimestamp;
+    this->_scratch = deadObj._scratch;
+    this->_scratchSize = deadObj._scratchSize;
+    this->_writeBuffer = deadObj._writeBuffer;
+    this->_writeBufferSize = deadObj._writeBufferSize;
+    this->_writeBufferUsed = deadObj._writeBufferUsed;
+    this->_maximumFileSize = deadObj._maximumFileSize;
+    this->_rotationInterval = deadObj._rotationInterval;
+    this->_fileBytes = deadObj._fileBytes;
+    this->_fileOpenedAt = deadObj._fileOpenedAt;
+    this->_memoryMapped = deadObj._memoryMapped;
+    this->_timestamps = deadObj._timestamps;
+#ifndef ARDUINO
+    this->_mapping = deadObj._mapping;
+    this->_mappingSize = deadObj._mappingSize;
+    this->_mappingUsed = deadObj._mappingUsed;
+
+    deadObj._mapping = nullptr;
+    deadObj._mappingSize = 0;
+    deadObj._mappingUsed = 0;
+
+    this->TakeRotation(deadObj);
+    this->TakeGroupCommit(deadObj);
+#endif
 
     deadObj._fileNameFmt = nullptr;
     deadObj._fileName = nullptr;
     deadObj._fileOpen = false;
+    deadObj._dictionary = nullptr;
+    deadObj._dictionaryCapacity = 0;
+    deadObj._scratch = nullptr;
+    deadObj._scratchSize = 0;
+    deadObj._writeBuffer = nullptr;
+    deadObj._writeBufferSize = 0;
+    deadObj._writeBufferUsed = 0;
 
     return *this;
 }
@@ -237,23 +1640,7 @@ SPIN::Log::Sinks::FileSink& SPIN::Log::Sinks::FileSink::operator=(SPIN::Log::Sin
 
 SPIN::Log::Sinks::FileSink::~FileSink()
 {
-    this->CloseFile();
-
-    if (this->_fileNameFmt != nullptr)
-    {
-        free((void*)(this->_fileNameFmt));
-    }
-    this->_fileNameFmt = nullptr;
-    this->_fileNameFmtSize = 0;
-
-    if (this->_fileName != nullptr)
-    {
-        free((void*)(this->_fileName));
-    }
-    this->_fileName = nullptr;
-    this->_fileNameSize = 0;
-
-    this->_counter = 0;
+    this->Release();
 }
 
 
@@ -262,11 +1649,29 @@ SPIN::Log::Sinks::Factory::FileSinkFactory::FileSinkFactory() = default;
 SPIN::Log::Sinks::Factory::FileSinkFactory::FileSinkFactory(const SPIN::Log::Sinks::Factory::FileSinkFactory& obj)
 {
     this->SetFileNameFormatter(obj._fileNameFmt);
+    this->_minimumLevel = obj._minimumLevel;
+    this->_binary = obj._binary;
+    this->_bufferSize = obj._bufferSize;
+    this->_maximumFileSize = obj._maximumFileSize;
+    this->_rotationInterval = obj._rotationInterval;
+    this->_memoryMapped = obj._memoryMapped;
+    this->_timestamps = obj._timestamps;
+    this->_durable = obj._durable;
+    this->_commitWindow = obj._commitWindow;
 }
 SPIN::Log::Sinks::Factory::FileSinkFactory::FileSinkFactory(SPIN::Log::Sinks::Factory::FileSinkFactory&& deadObj) noexcept
 {
     this->_fileNameFmt = deadObj._fileNameFmt;
     this->_fileNameFmtSize = deadObj._fileNameFmtSize;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_binary = deadObj._binary;
+    this->_bufferSize = deadObj._bufferSize;
+    this->_maximumFileSize = deadObj._maximumFileSize;
+    this->_rotationInterval = deadObj._rotationInterval;
+    this->_memoryMapped = deadObj._memoryMapped;
+    this->_timestamps = deadObj._timestamps;
+    this->_durable = deadObj._durable;
+    this->_commitWindow = deadObj._commitWindow;
 
     deadObj._fileNameFmt = nullptr;
     deadObj._fileNameFmtSize = 0;
@@ -316,11 +1721,85 @@ SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkF
 
     return *this;
 }
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+{
+    this->_minimumLevel = logLevel;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetBinary(bool binary)
+{
+    this->_binary = binary;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetBufferSize(std::size_t bufferSize)
+{
+    this->_bufferSize = bufferSize;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetTimestamps(bool timestamps)
+{
+    this->_timestamps = timestamps;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetDurable(bool durable)
+{
+    this->_durable = durable;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetCommitWindow(uint32_t microseconds)
+{
+    this->_commitWindow = microseconds;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetMemoryMapped(bool memoryMapped)
+{
+    this->_memoryMapped = memoryMapped;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetMaximumFileSize(std::size_t maximumFileSize)
+{
+    this->_maximumFileSize = maximumFileSize;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::SetRotationInterval(uint32_t seconds)
+{
+    this->_rotationInterval = (uint64_t)seconds * 1000000;
+
+    return *this;
+}
 
 
 SPIN::Log::Sinks::FileSink SPIN::Log::Sinks::Factory::FileSinkFactory::Build()
 {
     auto sink = SPIN::Log::Sinks::FileSink(this->_fileNameFmt);
+    sink.SetMinimumLevel(this->_minimumLevel);
+    sink._binary = this->_binary;
+    sink._maximumFileSize = this->_maximumFileSize;
+    sink._rotationInterval = this->_rotationInterval;
+    sink._timestamps = this->_timestamps;
+#if defined(__LOGGER__SPIN__LOG__SINKS__FILESINK__POSIX__)
+    sink._memoryMapped = this->_memoryMapped;
+#endif
+    if (!sink.SetWriteBufferSize(sink._memoryMapped ? 0 : this->_bufferSize))
+    {
+#ifndef ARDUINO
+        throw std::exception();
+#endif
+    }
+#ifndef ARDUINO
+    if (this->_durable)
+    {
+        sink.EnableGroupCommit(this->_commitWindow);
+    }
+#endif
 
     return sink;
 }
@@ -329,6 +1808,15 @@ SPIN::Log::Sinks::FileSink SPIN::Log::Sinks::Factory::FileSinkFactory::Build()
 SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkFactory::operator=(const SPIN::Log::Sinks::Factory::FileSinkFactory& obj)
 {
     this->SetFileNameFormatter(obj._fileNameFmt);
+    this->_minimumLevel = obj._minimumLevel;
+    this->_binary = obj._binary;
+    this->_bufferSize = obj._bufferSize;
+    this->_maximumFileSize = obj._maximumFileSize;
+    this->_rotationInterval = obj._rotationInterval;
+    this->_memoryMapped = obj._memoryMapped;
+    this->_timestamps = obj._timestamps;
+    this->_durable = obj._durable;
+    this->_commitWindow = obj._commitWindow;
 
     return *this;
 }
@@ -336,6 +1824,15 @@ SPIN::Log::Sinks::Factory::FileSinkFactory& SPIN::Log::Sinks::Factory::FileSinkF
 {
     this->_fileNameFmt = deadObj._fileNameFmt;
     this->_fileNameFmtSize = deadObj._fileNameFmtSize;
+    this->_minimumLevel = deadObj._minimumLevel;
+    this->_binary = deadObj._binary;
+    this->_bufferSize = deadObj._bufferSize;
+    this->_maximumFileSize = deadObj._maximumFileSize;
+    this->_rotationInterval = deadObj._rotationInterval;
+    this->_memoryMapped = deadObj._memoryMapped;
+    this->_timestamps = deadObj._timestamps;
+    this->_durable = deadObj._durable;
+    this->_commitWindow = deadObj._commitWindow;
 
     deadObj._fileNameFmt = nullptr;
     deadObj._fileNameFmtSize = 0;
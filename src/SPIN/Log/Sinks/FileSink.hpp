@@ -28,11 +28,19 @@
 #ifdef ARDUINO
     #include <Arduino.h>
     #include <SD.h>
+    #include <stddef.h>
+    #include <stdint.h>
 #else
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdio>
+    #include <atomic>
     #include <ostream>
 #endif
 
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/Metrics.hpp>
+#include <SPIN/Log/Format/TimestampPrefix.hpp>
 #include <SPIN/Log/Sinks/ISink.hpp>
 
 namespace SPIN
@@ -46,6 +54,25 @@ namespace SPIN
                 class FileSinkFactory;
             }
 
+#ifndef ARDUINO
+            struct CommitStatistics
+            {
+                uint64_t commits;
+                uint64_t records;
+                uint64_t waits;
+                uint64_t failures;
+                // Time spent in fdatasync per commit, and by callers in WaitPersisted.
+                SPIN::Log::Metrics::HistogramSnapshot sync;
+                SPIN::Log::Metrics::HistogramSnapshot wait;
+            };
+#endif
+
+            /**
+             * In durable mode callers can wait until what they logged is on disk. A waiter flushes
+             * under the sink's lock, then one thread per sink runs a single fdatasync for all
+             * waiters so far, at most once per commit window. Rotated out files are synced by the
+             * same thread, off the write path.
+             **/
             class FileSink : public SPIN::Log::Sinks::ISink
             {
                 private:
@@ -54,6 +81,7 @@ namespace SPIN
                     char* _fileName = nullptr;
                     std::size_t _fileNameSize = 0;
                     uint32_t _counter = 0;
+                    bool _counterScanned = false;
                     bool _fileOpen = false;
 #ifdef ARDUINO
                     File _fptr;
@@ -61,11 +89,99 @@ namespace SPIN
                     FILE* _fptr = nullptr;
 #endif
 
+                    struct DictionaryEntry
+                    {
+                        const char* format;
+                        uint32_t id;
+                    };
+
+                    bool _binary = false;
+                    DictionaryEntry* _dictionary = nullptr;
+                    std::size_t _dictionaryCapacity = 0;
+                    uint32_t _dictionarySize = 0;
+                    uint64_t _lastTimestamp = 0;
+                    uint8_t* _scratch = nullptr;
+                    std::size_t _scratchSize = 0;
+
+                    char* _writeBuffer = nullptr;
+                    std::size_t _writeBufferSize = 0;
+                    std::size_t _writeBufferUsed = 0;
+
+                    std::size_t _maximumFileSize = 0;
+                    uint64_t _rotationInterval = 0;
+                    std::size_t _fileBytes = 0;
+                    uint64_t _fileOpenedAt = 0;
+
+                    bool _memoryMapped = false;
+                    bool _timestamps = false;
+                    SPIN::Log::Format::TimestampPrefix _prefix;
+#ifndef ARDUINO
+                    char* _mapping = nullptr;
+                    std::size_t _mappingSize = 0;
+                    std::size_t _mappingUsed = 0;
+
+                    /**
+                     * Rotated out files are closed off the write path, the next file is only created
+                     * when it takes over so a crash never leaves an empty one behind.
+                     **/
+                    struct FileCloser;
+
+                    FileCloser* _fileCloser = nullptr;
+                    char* _nextFileName = nullptr;
+                    // When the next file last failed to open, 0 if it did not.
+                    uint64_t _nextFailedAt = 0;
+
+                    struct GroupCommit;
+
+                    bool _durable = false;
+                    uint64_t _commitWindow = 0;
+                    GroupCommit* _groupCommit = nullptr;
+                    std::atomic<uint64_t> _written{ 0 };
+#endif
+
                     FileSink(char*);
 
                     bool SetFileNameFmt(char*);
+                    bool SetWriteBufferSize(std::size_t);
+                    void ScanExistingFiles();
+                    bool FindNextFileName(char*);
                     bool OpenNextFile();
+                    bool StartFile();
                     void CloseFile();
+                    // Closes the file and frees everything the sink owns, for the destructor and assignments.
+                    void Release();
+
+                    bool ShouldRotate() const;
+                    bool EnsureFileReady();
+                    bool RotateFile();
+#ifndef ARDUINO
+                    void RetireFile(FILE*);
+                    void DiscardRotation();
+                    void TakeRotation(FileSink&);
+
+                    void EnableGroupCommit(uint64_t);
+                    void DisableGroupCommit();
+                    void TakeGroupCommit(FileSink&);
+#endif
+
+                    bool WriteThrough(const void*, std::size_t, const void*, std::size_t);
+                    bool FlushWriteBuffer();
+#ifndef ARDUINO
+                    std::size_t InitialMappingSize() const;
+                    bool AllocateFile(int, std::size_t);
+                    bool MapFile(std::size_t);
+                    void UnmapFile();
+                    bool WriteMapped(const void*, std::size_t);
+#endif
+                    bool Write(const void*, std::size_t);
+                    bool WriteVarint(uint64_t);
+                    bool WriteHeader();
+                    bool WriteTimestamp(uint64_t);
+                    bool LookupFormat(const char*, uint32_t&, bool&);
+                    bool ReserveScratch(std::size_t);
+                    void WriteRecord(SPIN::Log::LogLevel, uint64_t, const char*, std::size_t);
+                    void PrintRecord(SPIN::Log::LogLevel, uint64_t, const char*);
+                    void CountWritten(std::size_t);
 
                     friend class SPIN::Log::Sinks::Factory::FileSinkFactory;
 
@@ -75,7 +191,26 @@ namespace SPIN
                     FileSink(FileSink&&) noexcept;
 
                     void Handle(SPIN::Log::LogLevel, const char*) override;
+                    void Handle(const SPIN::Log::LogRecord&) override;
+                    void HandleBatch(const SPIN::Log::LogRecord*, std::size_t) override;
                     void Flush() override;
+                    bool HandleDeferred(SPIN::Log::LogLevel, uint64_t, const char*, const uint8_t*, std::size_t) override;
+
+#ifndef ARDUINO
+                    /** Records written so far, pass it to WaitPersisted to wait for them. **/
+                    uint64_t GetWrittenCount() const;
+                    /**
+                     * Blocks until the first count records are on disk. Returns false when the
+                     * sink is not durable or the sync failed.
+                     **/
+                    bool WaitPersisted(uint64_t);
+                    /**
+                     * Waits for everything written so far. An AsyncLogger needs a Flush first, so
+                     * its queued records reach the sink.
+                     **/
+                    bool Sync();
+                    CommitStatistics GetCommitStatistics() const;
+#endif
 
                     FileSink& operator=(const FileSink&);
                     FileSink& operator=(FileSink&&) noexcept;
@@ -90,6 +225,19 @@ namespace SPIN
                     private:
                         char* _fileNameFmt = nullptr;
                         std::size_t _fileNameFmtSize = 0;
+                        SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+                        bool _binary = false;
+#ifdef ARDUINO
+                        std::size_t _bufferSize = 0;
+#else
+                        std::size_t _bufferSize = 64 * 1024;
+#endif
+                        std::size_t _maximumFileSize = 0;
+                        uint64_t _rotationInterval = 0;
+                        bool _memoryMapped = false;
+                        bool _timestamps = false;
+                        bool _durable = false;
+                        uint32_t _commitWindow = 1000;
 
                     public:
                         FileSinkFactory();
@@ -97,6 +245,17 @@ namespace SPIN
                         FileSinkFactory(FileSinkFactory&&) noexcept;
 
                         FileSinkFactory& SetFileNameFormatter(const char*);
+                        FileSinkFactory& SetMinimumLevel(SPIN::Log::LogLevel);
+                        FileSinkFactory& SetBinary(bool);
+                        FileSinkFactory& SetBufferSize(std::size_t);
+                        FileSinkFactory& SetMemoryMapped(bool);
+                        FileSinkFactory& SetTimestamps(bool);
+                        /** Lets callers wait for their records to reach the disk, POSIX only. **/
+                        FileSinkFactory& SetDurable(bool);
+                        /** Least microseconds between two commits, a lone wait after a quiet spell syncs at once. **/
+                        FileSinkFactory& SetCommitWindow(uint32_t);
+                        FileSinkFactory& SetMaximumFileSize(std::size_t);
+                        FileSinkFactory& SetRotationInterval(uint32_t);
 
                         SPIN::Log::Sinks::FileSink Build();
 
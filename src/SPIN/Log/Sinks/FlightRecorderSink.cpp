@@ -0,0 +1,542 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Sinks/FlightRecorderSink.hpp>
+
+#ifndef ARDUINO
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <SPIN/Log/Clock.hpp>
+#include <SPIN/Log/Format/NumberFormat.hpp>
+
+
+static const char levelTag[6][7] = {
+    "[VER]:",
+    "[DEB]:",
+    "[INF]:",
+    "[WAR]:",
+    "[ERR]:",
+    "[FAT]:"
+};
+
+static const int crashSignals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+static const std::size_t numberOfCrashSignals = sizeof(crashSignals) / sizeof(crashSignals[0]);
+static std::atomic<SPIN::Log::Sinks::FlightRecorderSink*> crashSink{ nullptr };
+static struct sigaction previousActions[numberOfCrashSignals];
+
+namespace
+{
+    void CrashHandler(int signalNumber)
+    {
+        int savedErrno = errno;
+
+        SPIN::Log::Sinks::FlightRecorderSink* sink = crashSink.load(std::memory_order_acquire);
+        if (sink != nullptr)
+        {
+            sink->DumpFromSignal();
+        }
+
+        // Hand the signal to whoever was installed before, the default action ends the process.
+        for (std::size_t i = 0; i < numberOfCrashSignals; i++)
+        {
+            if (crashSignals[i] == signalNumber)
+            {
+                sigaction(signalNumber, &(previousActions[i]), nullptr);
+            }
+        }
+        errno = savedErrno;
+        raise(signalNumber);
+    }
+
+    /** write() until everything is out, only async-signal-safe calls. **/
+    bool WriteAll(int fd, const char* data, std::size_t length)
+    {
+        while (length > 0)
+        {
+            ssize_t written = write(fd, data, length);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            data += written;
+            length -= (std::size_t)written;
+        }
+
+        return true;
+    }
+
+    std::size_t AppendText(char* out, const char* text)
+    {
+        std::size_t length = strlen(text);
+        memcpy((void*)out, (const void*)text, length);
+
+        return length;
+    }
+}
+
+
+
+SPIN::Log::Sinks::FlightRecorderSink::FlightRecorderSink(std::size_t capacity, std::size_t recordSize)
+{
+    std::size_t rounded = 1;
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    this->_capacity = rounded;
+    this->_recordSize = recordSize;
+    this->_slotStride = (sizeof(Slot) + recordSize + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    // Every slot is touched here, recording never faults in a fresh page.
+    this->_slots = (char*)malloc(this->_capacity * this->_slotStride);
+    if (this->_slots == nullptr)
+    {
+        throw std::exception();
+    }
+    memset((void*)(this->_slots), 0, this->_capacity * this->_slotStride);
+
+    for (std::size_t i = 0; i < this->_capacity; i++)
+    {
+        new (&(this->SlotAt(i)->sequence)) std::atomic<uint64_t>(0);
+    }
+}
+SPIN::Log::Sinks::FlightRecorderSink::FlightRecorderSink(SPIN::Log::Sinks::FlightRecorderSink&& deadObj) noexcept : SPIN::Log::Sinks::ISink(deadObj)
+{
+    this->_slots = deadObj._slots;
+    this->_capacity = deadObj._capacity;
+    this->_recordSize = deadObj._recordSize;
+    this->_slotStride = deadObj._slotStride;
+    this->_position.store(deadObj._position.load());
+    this->_lost.store(deadObj._lost.load());
+    this->_fileName = deadObj._fileName;
+    this->_dumpOnFatal = deadObj._dumpOnFatal;
+
+    SPIN::Log::Sinks::FlightRecorderSink* expected = &deadObj;
+    crashSink.compare_exchange_strong(expected, this);
+
+    deadObj._slots = nullptr;
+    deadObj._capacity = 0;
+    deadObj._fileName = nullptr;
+}
+
+
+SPIN::Log::Sinks::FlightRecorderSink::Slot* SPIN::Log::Sinks::FlightRecorderSink::SlotAt(uint64_t position) const
+{
+    return (Slot*)(this->_slots + (std::size_t)(position & (this->_capacity - 1)) * this->_slotStride);
+}
+bool SPIN::Log::Sinks::FlightRecorderSink::SetFileName(const char* fileName)
+{
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+        this->_fileName = nullptr;
+    }
+    if (fileName == nullptr)
+    {
+        return true;
+    }
+
+    std::size_t length = strlen(fileName);
+    this->_fileName = (char*)malloc(length + 1);
+    if (this->_fileName == nullptr)
+    {
+        return false;
+    }
+    memcpy((void*)(this->_fileName), (const void*)fileName, length + 1);
+
+    return true;
+}
+void SPIN::Log::Sinks::FlightRecorderSink::Record(SPIN::Log::LogLevel logLevel, uint64_t timestamp, const char* message, std::size_t length)
+{
+    if (this->_slots == nullptr)
+    {
+        return;
+    }
+
+    uint64_t position = this->_position.fetch_add(1, std::memory_order_relaxed);
+    Slot* slot = this->SlotAt(position);
+
+    // The slot is still owned by a writer one lap behind, or a newer lap already took it.
+    uint64_t expected = slot->sequence.load(std::memory_order_relaxed);
+    if ((expected & 1) != 0 || expected > 2 * position
+        || !slot->sequence.compare_exchange_strong(expected, 2 * position + 1, std::memory_order_relaxed))
+    {
+        this->_lost.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (length > this->_recordSize)
+    {
+        length = this->_recordSize;
+    }
+    slot->timestamp = timestamp;
+    slot->level = logLevel;
+    slot->length = (uint32_t)length;
+    memcpy((void*)((char*)slot + sizeof(Slot)), (const void*)message, length);
+
+    slot->sequence.store(2 * position + 2, std::memory_order_release);
+}
+bool SPIN::Log::Sinks::FlightRecorderSink::WriteDump(const char* reason)
+{
+    if (this->_fileName == nullptr || this->_slots == nullptr || this->_dumping.test_and_set(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    int fd = open(this->_fileName, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        this->_dumping.clear(std::memory_order_release);
+        return false;
+    }
+
+    char out[4096];
+    std::size_t used = 0;
+    bool written = true;
+
+    used += AppendText(out + used, "--- flight recorder dump (");
+    used += AppendText(out + used, reason);
+    used += AppendText(out + used, "), ");
+    used += SPIN::Log::Format::FormatDecimal(out + used, this->_lost.load(std::memory_order_relaxed));
+    used += AppendText(out + used, " records lost ---\n");
+
+    uint64_t end = this->_position.load(std::memory_order_acquire);
+    uint64_t begin = (end > this->_capacity) ? end - this->_capacity : 0;
+    for (uint64_t position = begin; position < end && written; position++)
+    {
+        const Slot* slot = this->SlotAt(position);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * position + 2)
+        {
+            continue;
+        }
+
+        std::size_t length = slot->length;
+        if (length > sizeof(out) - 32 - SPIN::Log::Format::DecimalCapacity)
+        {
+            length = sizeof(out) - 32 - SPIN::Log::Format::DecimalCapacity;
+        }
+        if (used + length + 32 + SPIN::Log::Format::DecimalCapacity > sizeof(out))
+        {
+            written = WriteAll(fd, out, used);
+            used = 0;
+        }
+
+        std::size_t start = used;
+        uint8_t level = (uint8_t)(slot->level);
+        used += SPIN::Log::Format::FormatDecimal(out + used, slot->timestamp);
+        out[used++] = ' ';
+        used += AppendText(out + used, levelTag[(level < 6) ? level : 5]);
+        out[used++] = ' ';
+        memcpy((void*)(out + used), (const void*)((const char*)slot + sizeof(Slot)), length);
+        used += length;
+        out[used++] = '\n';
+
+        // A writer lapped us while copying, the line is torn.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            used = start;
+        }
+    }
+    if (written && used > 0)
+    {
+        written = WriteAll(fd, out, used);
+    }
+
+    close(fd);
+    this->_dumping.clear(std::memory_order_release);
+
+    return written;
+}
+
+void SPIN::Log::Sinks::FlightRecorderSink::Handle(SPIN::Log::LogLevel logLevel, const char* message)
+{
+    SPIN::Log::LogRecord record = {};
+    record.level = logLevel;
+    record.message = message;
+    record.length = strlen(message);
+    record.timestamp = SPIN::Log::Clock::Microseconds();
+
+    this->Handle(record);
+}
+void SPIN::Log::Sinks::FlightRecorderSink::Handle(const SPIN::Log::LogRecord& record)
+{
+    this->Record(record.level, record.timestamp, record.message, record.length);
+
+    if (this->_dumpOnFatal && record.level == SPIN::Log::LogLevel::Fatal)
+    {
+        this->WriteDump("fatal");
+    }
+}
+void SPIN::Log::Sinks::FlightRecorderSink::Flush()
+{
+}
+
+bool SPIN::Log::Sinks::FlightRecorderSink::Dump()
+{
+    return this->WriteDump("requested");
+}
+bool SPIN::Log::Sinks::FlightRecorderSink::DumpFromSignal()
+{
+    return this->WriteDump("signal");
+}
+
+bool SPIN::Log::Sinks::FlightRecorderSink::InstallCrashHandler()
+{
+    SPIN::Log::Sinks::FlightRecorderSink* expected = nullptr;
+    if (!crashSink.compare_exchange_strong(expected, this))
+    {
+        return expected == this;
+    }
+
+    struct sigaction action;
+    memset((void*)&action, 0, sizeof(action));
+    action.sa_handler = CrashHandler;
+    action.sa_flags = SA_ONSTACK;
+    sigemptyset(&(action.sa_mask));
+
+    for (std::size_t i = 0; i < numberOfCrashSignals; i++)
+    {
+        sigaction(crashSignals[i], &action, &(previousActions[i]));
+    }
+
+    return true;
+}
+void SPIN::Log::Sinks::FlightRecorderSink::RemoveCrashHandler()
+{
+    if (crashSink.load() != this)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < numberOfCrashSignals; i++)
+    {
+        sigaction(crashSignals[i], &(previousActions[i]), nullptr);
+    }
+    crashSink.store(nullptr);
+}
+
+uint64_t SPIN::Log::Sinks::FlightRecorderSink::GetRecordedCount() const
+{
+    return this->_position.load(std::memory_order_relaxed);
+}
+uint64_t SPIN::Log::Sinks::FlightRecorderSink::GetLostCount() const
+{
+    return this->_lost.load(std::memory_order_relaxed);
+}
+
+
+SPIN::Log::Sinks::FlightRecorderSink& SPIN::Log::Sinks::FlightRecorderSink::operator=(SPIN::Log::Sinks::FlightRecorderSink&& deadObj) noexcept
+{
+    this->RemoveCrashHandler();
+    if (this->_slots != nullptr)
+    {
+        free((void*)(this->_slots));
+    }
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+    }
+
+    this->_slots = deadObj._slots;
+    this->_capacity = deadObj._capacity;
+    this->_recordSize = deadObj._recordSize;
+    this->_slotStride = deadObj._slotStride;
+    this->_position.store(deadObj._position.load());
+    this->_lost.store(deadObj._lost.load());
+    this->_fileName = deadObj._fileName;
+    this->_dumpOnFatal = deadObj._dumpOnFatal;
+    SPIN::Log::Sinks::ISink::operator=(deadObj);
+
+    SPIN::Log::Sinks::FlightRecorderSink* expected = &deadObj;
+    crashSink.compare_exchange_strong(expected, this);
+
+    deadObj._slots = nullptr;
+    deadObj._capacity = 0;
+    deadObj._fileName = nullptr;
+
+    return *this;
+}
+
+
+SPIN::Log::Sinks::FlightRecorderSink::~FlightRecorderSink()
+{
+    this->RemoveCrashHandler();
+
+    if (this->_slots != nullptr)
+    {
+        free((void*)(this->_slots));
+    }
+    this->_slots = nullptr;
+    this->_capacity = 0;
+
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+    }
+    this->_fileName = nullptr;
+}
+
+
+
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::FlightRecorderSinkFactory() = default;
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::FlightRecorderSinkFactory(const SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& obj)
+{
+    *this = obj;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::FlightRecorderSinkFactory(SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory&& deadObj) noexcept
+{
+    this->_fileName = deadObj._fileName;
+    this->_capacity = deadObj._capacity;
+    this->_recordSize = deadObj._recordSize;
+    this->_dumpOnFatal = deadObj._dumpOnFatal;
+    this->_minimumLevel = deadObj._minimumLevel;
+
+    deadObj._fileName = nullptr;
+}
+
+
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::SetFileName(const char* fileName)
+{
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+        this->_fileName = nullptr;
+    }
+    if (fileName == nullptr)
+    {
+        return *this;
+    }
+
+    std::size_t length = strlen(fileName);
+    this->_fileName = (char*)malloc(length + 1);
+    if (this->_fileName == nullptr)
+    {
+        throw std::exception();
+    }
+    memcpy((void*)(this->_fileName), (const void*)fileName, length + 1);
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::SetCapacity(std::size_t capacity)
+{
+    this->_capacity = (capacity > 0) ? capacity : 1;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::SetRecordSize(std::size_t recordSize)
+{
+    this->_recordSize = recordSize;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::SetDumpOnFatal(bool dumpOnFatal)
+{
+    this->_dumpOnFatal = dumpOnFatal;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+{
+    this->_minimumLevel = logLevel;
+
+    return *this;
+}
+
+
+SPIN::Log::Sinks::FlightRecorderSink SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::Build()
+{
+    auto sink = SPIN::Log::Sinks::FlightRecorderSink(this->_capacity, this->_recordSize);
+    sink.SetMinimumLevel(this->_minimumLevel);
+    sink._dumpOnFatal = this->_dumpOnFatal;
+    if (!sink.SetFileName(this->_fileName))
+    {
+        throw std::exception();
+    }
+
+    return sink;
+}
+
+
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::operator=(const SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& obj)
+{
+    if (this == &obj)
+    {
+        return *this;
+    }
+
+    this->SetFileName(obj._fileName);
+    this->_capacity = obj._capacity;
+    this->_recordSize = obj._recordSize;
+    this->_dumpOnFatal = obj._dumpOnFatal;
+    this->_minimumLevel = obj._minimumLevel;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory& SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::operator=(SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory&& deadObj) noexcept
+{
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+    }
+
+    this->_fileName = deadObj._fileName;
+    this->_capacity = deadObj._capacity;
+    this->_recordSize = deadObj._recordSize;
+    this->_dumpOnFatal = deadObj._dumpOnFatal;
+    this->_minimumLevel = deadObj._minimumLevel;
+
+    deadObj._fileName = nullptr;
+
+    return *this;
+}
+
+
+SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory::~FlightRecorderSinkFactory()
+{
+    if (this->_fileName != nullptr)
+    {
+        free((void*)(this->_fileName));
+    }
+    this->_fileName = nullptr;
+}
+
+#endif
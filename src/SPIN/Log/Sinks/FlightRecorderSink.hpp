@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__SINKS_FLIGHTRECORDERSINK__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__SINKS_FLIGHTRECORDERSINK__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Sinks/ISink.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Sinks
+        {
+            namespace Factory
+            {
+                class FlightRecorderSinkFactory;
+            }
+
+            /**
+             * Keeps the most recent records in a preallocated ring and writes them to a file on a
+             * Fatal record, on Dump or from a crash signal. Recording never takes a lock, a record
+             * whose slot is still being written by a much older record is counted as lost instead.
+             **/
+            class FlightRecorderSink : public SPIN::Log::Sinks::ISink
+            {
+                private:
+                    struct Slot
+                    {
+                        /** 2 * position + 1 while the record is written, 2 * position + 2 once it is complete. **/
+                        std::atomic<uint64_t> sequence;
+                        uint64_t timestamp;
+                        uint32_t length;
+                        SPIN::Log::LogLevel level;
+                    };
+
+                    char* _slots = nullptr;
+                    std::size_t _capacity = 0;
+                    std::size_t _recordSize = 0;
+                    std::size_t _slotStride = 0;
+                    std::atomic<uint64_t> _position{ 0 };
+                    std::atomic<uint64_t> _lost{ 0 };
+                    std::atomic_flag _dumping = ATOMIC_FLAG_INIT;
+
+                    char* _fileName = nullptr;
+                    bool _dumpOnFatal = true;
+
+                    FlightRecorderSink(std::size_t, std::size_t);
+
+                    Slot* SlotAt(uint64_t) const;
+                    bool SetFileName(const char*);
+                    void Record(SPIN::Log::LogLevel, uint64_t, const char*, std::size_t);
+                    bool WriteDump(const char*);
+
+                    friend class SPIN::Log::Sinks::Factory::FlightRecorderSinkFactory;
+
+                public:
+                    FlightRecorderSink() = delete;
+                    FlightRecorderSink(const FlightRecorderSink&) = delete;
+                    FlightRecorderSink(FlightRecorderSink&&) noexcept;
+
+                    void Handle(SPIN::Log::LogLevel, const char*) override;
+                    void Handle(const SPIN::Log::LogRecord&) override;
+                    void Flush() override;
+
+                    /**
+                     * Appends the recorded records, oldest first, to the file. Returns false when the
+                     * file cannot be written or another dump is running.
+                     **/
+                    bool Dump();
+                    /**
+                     * Same as Dump with only async-signal-safe calls, for use in a signal handler.
+                     **/
+                    bool DumpFromSignal();
+
+                    /**
+                     * Dumps this sink when the process receives SIGSEGV, SIGBUS, SIGILL, SIGFPE or SIGABRT,
+                     * then lets the signal take its default action. One sink can be installed at a time.
+                     **/
+                    bool InstallCrashHandler();
+                    void RemoveCrashHandler();
+
+                    uint64_t GetRecordedCount() const;
+                    uint64_t GetLostCount() const;
+
+                    FlightRecorderSink& operator=(const FlightRecorderSink&) = delete;
+                    FlightRecorderSink& operator=(FlightRecorderSink&&) noexcept;
+
+                    ~FlightRecorderSink();
+            };
+
+            namespace Factory
+            {
+                class FlightRecorderSinkFactory
+                {
+                    private:
+                        char* _fileName = nullptr;
+                        std::size_t _capacity = 4096;
+                        std::size_t _recordSize = 256;
+                        bool _dumpOnFatal = true;
+                        SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+
+                    public:
+                        FlightRecorderSinkFactory();
+                        FlightRecorderSinkFactory(const FlightRecorderSinkFactory&);
+                        FlightRecorderSinkFactory(FlightRecorderSinkFactory&&) noexcept;
+
+                        FlightRecorderSinkFactory& SetFileName(const char*);
+                        /** Number of records kept, rounded up to a power of two. **/
+                        FlightRecorderSinkFactory& SetCapacity(std::size_t);
+                        /** Longest message kept per record, longer ones are truncated. **/
+                        FlightRecorderSinkFactory& SetRecordSize(std::size_t);
+                        FlightRecorderSinkFactory& SetDumpOnFatal(bool);
+                        FlightRecorderSinkFactory& SetMinimumLevel(SPIN::Log::LogLevel);
+
+                        SPIN::Log::Sinks::FlightRecorderSink Build();
+
+                        FlightRecorderSinkFactory& operator=(const FlightRecorderSinkFactory&);
+                        FlightRecorderSinkFactory& operator=(FlightRecorderSinkFactory&&) noexcept;
+
+                        ~FlightRecorderSinkFactory();
+                };
+            }
+        }
+    }
+}
+
+#endif
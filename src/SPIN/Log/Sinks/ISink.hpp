@@ -25,19 +25,397 @@
 #if !defined(__LOGGER__SPIN__LOG__SINKS_ISINK__H__) && defined(__cplusplus)
 #define __LOGGER__SPIN__LOG__SINKS_ISINK__H__
 
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <atomic>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdlib>
+    #include <exception>
+    #include <new>
+#endif
+
+#include <SPIN/Log/Clock.hpp>
+#include <SPIN/Log/FlushPolicy.hpp>
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Metrics.hpp>
+#include <SPIN/Log/Concurrent/SpinLock.hpp>
 
 namespace SPIN
 {
     namespace Log
     {
+        class FlushTimer;
+
         namespace Sinks
         {
             class ISink
             {
+                protected:
+                    SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
+                    SPIN::Log::FlushPolicy _flushPolicy;
+                    uint32_t _pendingRecords = 0;
+                    uint32_t _pendingBytes = 0;
+#ifndef ARDUINO
+                    SPIN::Log::Concurrent::SpinLock _lock;
+                    SPIN::Log::Metrics::SinkMetrics* _metrics = nullptr;
+                    /**
+                     * Taken around every delivery when another thread may flush the sink, that is with a
+                     * FlushPolicy interval (FlushTimer) or when the sink sets _externalFlush itself (group
+                     * commit). Both are configuration, fixed before the sink is handed to a logger.
+                     **/
+                    SPIN::Log::Concurrent::SpinLock _flushLock;
+                    bool _externalFlush = false;
+                    uint64_t _lastFlush = 0;
+#endif
+
+                    bool BeginDelivery()
+                    {
+#ifndef ARDUINO
+                        if (this->_flushPolicy.interval != 0 || this->_externalFlush)
+                        {
+                            this->_flushLock.Lock();
+                            return true;
+                        }
+#endif
+                        return false;
+                    }
+                    void EndDelivery(bool locked, SPIN::Log::LogLevel logLevel, uint32_t records, std::size_t bytes)
+                    {
+                        this->_pendingRecords += records;
+                        this->_pendingBytes += (uint32_t)bytes;
+
+                        const SPIN::Log::FlushPolicy& policy = this->_flushPolicy;
+                        if (records != 0
+                            && ((policy.onLevel && (uint8_t)logLevel >= (uint8_t)(policy.level))
+                                || (policy.records != 0 && this->_pendingRecords >= policy.records)
+                                || (policy.bytes != 0 && this->_pendingBytes >= policy.bytes)))
+                        {
+                            this->FlushPending();
+                        }
+
+#ifndef ARDUINO
+                        if (locked)
+                        {
+                            this->_flushLock.Unlock();
+                        }
+#else
+                        (void)locked;
+#endif
+                    }
+                    void FlushPending()
+                    {
+#ifndef ARDUINO
+                        if (this->_metrics != nullptr)
+                        {
+                            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+                            this->Flush();
+                            this->_metrics->CountFlush(SPIN::Log::Clock::Nanoseconds() - start);
+                        }
+                        else
+                        {
+                            this->Flush();
+                        }
+                        if (this->_flushPolicy.interval != 0)
+                        {
+                            this->_lastFlush = SPIN::Log::Clock::Microseconds();
+                        }
+#else
+                        this->Flush();
+#endif
+                        this->_pendingRecords = 0;
+                        this->_pendingBytes = 0;
+                    }
+#ifndef ARDUINO
+                    /**
+                     * Flushes when the interval ran out by now plus slack, so sinks due within the
+                     * same tick flush together. Returns when the sink is due next.
+                     **/
+                    uint64_t FlushIfDue(uint64_t now, uint64_t slack)
+                    {
+                        if (this->_flushPolicy.interval == 0)
+                        {
+                            return UINT64_MAX;
+                        }
+
+                        this->_flushLock.Lock();
+                        uint64_t due = this->_lastFlush + this->_flushPolicy.interval;
+                        if (due <= now + slack)
+                        {
+                            if (this->_pendingRecords != 0)
+                            {
+                                this->FlushPending();
+                            }
+                            this->_lastFlush = now;
+                            due = now + this->_flushPolicy.interval;
+                        }
+                        this->_flushLock.Unlock();
+
+                        return due;
+                    }
+
+                    friend class SPIN::Log::FlushTimer;
+#endif
+
                 public:
+                    ISink() = default;
+                    /** Copies start with metrics off, like the lock they start unlocked. **/
+                    ISink(const ISink& obj)
+                    {
+                        this->_minimumLevel = obj._minimumLevel;
+                        this->_flushPolicy = obj._flushPolicy;
+                    }
+
                     virtual void Handle(SPIN::Log::LogLevel, const char*) = 0;
                     virtual void Flush() = 0;
+
+                    /**
+                     * Receives the structured record. Sinks that only need the text keep the legacy Handle.
+                     **/
+                    virtual void Handle(const SPIN::Log::LogRecord& record)
+                    {
+                        this->Handle(record.level, record.message);
+                    }
+
+                    /**
+                     * Receives a contiguous run of records in one call. Records below the sink's minimum
+                     * level are skipped, sinks without a native implementation fall back to Handle.
+                     **/
+                    virtual void HandleBatch(const SPIN::Log::LogRecord* records, std::size_t count)
+                    {
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            if (this->Accepts(records[i].level))
+                            {
+                                this->Handle(records[i]);
+                            }
+                        }
+                    }
+
+                    /**
+                     * Receives a record whose formatting was deferred (format pointer plus captured
+                     * arguments). Returns false when the sink wants the rendered text through Handle instead.
+                     **/
+                    virtual bool HandleDeferred(SPIN::Log::LogLevel, uint64_t, const char*, const uint8_t*, std::size_t)
+                    {
+                        return false;
+                    }
+
+                    /**
+                     * What the loggers call instead of Handle, HandleBatch, HandleDeferred and Flush:
+                     * the same calls plus the sink's metrics when they are enabled.
+                     **/
+                    void Deliver(const SPIN::Log::LogRecord& record)
+                    {
+                        bool locked = this->BeginDelivery();
+#ifndef ARDUINO
+                        if (this->_metrics != nullptr)
+                        {
+                            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+                            this->Handle(record);
+                            this->_metrics->CountHandle(1, record.length, SPIN::Log::Clock::Nanoseconds() - start);
+                        }
+                        else
+                        {
+                            this->Handle(record);
+                        }
+#else
+                        this->Handle(record);
+#endif
+                        this->EndDelivery(locked, record.level, 1, record.length);
+                    }
+                    /**
+                     * Deliver for callers that know the sink's type, Sink::Handle is called without
+                     * virtual dispatch.
+                     **/
+                    template<typename Sink>
+                    void DeliverAs(const SPIN::Log::LogRecord& record)
+                    {
+                        bool locked = this->BeginDelivery();
+#ifndef ARDUINO
+                        if (this->_metrics != nullptr)
+                        {
+                            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+                            static_cast<Sink*>(this)->Sink::Handle(record);
+                            this->_metrics->CountHandle(1, record.length, SPIN::Log::Clock::Nanoseconds() - start);
+                        }
+                        else
+                        {
+                            static_cast<Sink*>(this)->Sink::Handle(record);
+                        }
+#else
+                        static_cast<Sink*>(this)->Sink::Handle(record);
+#endif
+                        this->EndDelivery(locked, record.level, 1, record.length);
+                    }
+                    void DeliverBatch(const SPIN::Log::LogRecord* records, std::size_t count)
+                    {
+                        uint32_t accepted = 0;
+                        std::size_t bytes = 0;
+                        SPIN::Log::LogLevel highest = SPIN::Log::LogLevel::Verbose;
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            if (this->Accepts(records[i].level))
+                            {
+                                accepted++;
+                                bytes += records[i].length;
+                                highest = ((uint8_t)(records[i].level) > (uint8_t)highest) ? records[i].level : highest;
+                            }
+                        }
+
+                        bool locked = this->BeginDelivery();
+#ifndef ARDUINO
+                        if (this->_metrics != nullptr)
+                        {
+                            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+                            this->HandleBatch(records, count);
+                            this->_metrics->CountHandle(accepted, bytes, SPIN::Log::Clock::Nanoseconds() - start);
+                        }
+                        else
+                        {
+                            this->HandleBatch(records, count);
+                        }
+#else
+                        this->HandleBatch(records, count);
+#endif
+                        this->EndDelivery(locked, highest, accepted, bytes);
+                    }
+                    bool DeliverDeferred(SPIN::Log::LogLevel logLevel, uint64_t timestamp, const char* fmt, const uint8_t* args, std::size_t length)
+                    {
+                        bool locked = this->BeginDelivery();
+                        bool handled;
+#ifndef ARDUINO
+                        if (this->_metrics != nullptr)
+                        {
+                            uint64_t start = SPIN::Log::Clock::Nanoseconds();
+                            handled = this->HandleDeferred(logLevel, timestamp, fmt, args, length);
+                            if (handled)
+                            {
+                                this->_metrics->CountHandle(1, length, SPIN::Log::Clock::Nanoseconds() - start);
+                            }
+                        }
+                        else
+                        {
+                            handled = this->HandleDeferred(logLevel, timestamp, fmt, args, length);
+                        }
+#else
+                        handled = this->HandleDeferred(logLevel, timestamp, fmt, args, length);
+#endif
+                        this->EndDelivery(locked, logLevel, handled ? 1 : 0, handled ? length : 0);
+
+                        return handled;
+                    }
+                    void DeliverFlush()
+                    {
+                        bool locked = this->BeginDelivery();
+                        this->FlushPending();
+                        this->EndDelivery(locked, SPIN::Log::LogLevel::Verbose, 0, 0);
+                    }
+
+                    /**
+                     * Lets the sink flush itself after deliveries, see FlushPolicy. Not thread safe,
+                     * set it before the sink is handed to a logger.
+                     **/
+                    void SetFlushPolicy(const SPIN::Log::FlushPolicy& policy)
+                    {
+                        this->_flushPolicy = policy;
+                    }
+                    const SPIN::Log::FlushPolicy& GetFlushPolicy() const
+                    {
+                        return this->_flushPolicy;
+                    }
+
+#ifndef ARDUINO
+                    /**
+                     * Turns the sink's counters and latency histograms on or off. Not thread safe,
+                     * enable before the sink is handed to a logger. Deferred records count their
+                     * captured argument bytes.
+                     **/
+                    void EnableMetrics(bool enable)
+                    {
+                        if (enable && this->_metrics == nullptr)
+                        {
+                            this->_metrics = (SPIN::Log::Metrics::SinkMetrics*)malloc(sizeof(SPIN::Log::Metrics::SinkMetrics));
+                            if (this->_metrics == nullptr)
+                            {
+                                throw std::exception();
+                            }
+                            new (this->_metrics) SPIN::Log::Metrics::SinkMetrics();
+                        }
+                        else if (!enable && this->_metrics != nullptr)
+                        {
+                            this->_metrics->~SinkMetrics();
+                            free((void*)(this->_metrics));
+                            this->_metrics = nullptr;
+                        }
+                    }
+                    /**
+                     * Sums the shards into snapshot. Returns false while metrics are off.
+                     **/
+                    bool GetMetrics(SPIN::Log::Metrics::SinkSnapshot& snapshot) const
+                    {
+                        if (this->_metrics == nullptr)
+                        {
+                            return false;
+                        }
+
+                        snapshot = this->_metrics->Snapshot();
+                        return true;
+                    }
+#endif
+
+                    bool Accepts(SPIN::Log::LogLevel logLevel) const
+                    {
+                        return (uint8_t)logLevel >= (uint8_t)(this->_minimumLevel);
+                    }
+
+                    SPIN::Log::LogLevel GetMinimumLevel() const
+                    {
+                        return this->_minimumLevel;
+                    }
+                    void SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+                    {
+                        this->_minimumLevel = logLevel;
+                    }
+
+                    void Lock()
+                    {
+#ifndef ARDUINO
+                        this->_lock.Lock();
+#endif
+                    }
+                    void Unlock()
+                    {
+#ifndef ARDUINO
+                        this->_lock.Unlock();
+#endif
+                    }
+                    uint64_t GetContentionCount() const
+                    {
+#ifndef ARDUINO
+                        return this->_lock.GetContentionCount();
+#else
+                        return 0;
+#endif
+                    }
+
+                    ISink& operator=(const ISink& obj)
+                    {
+                        this->_minimumLevel = obj._minimumLevel;
+                        this->_flushPolicy = obj._flushPolicy;
+
+                        return *this;
+                    }
+
+                    virtual ~ISink()
+                    {
+#ifndef ARDUINO
+                        this->EnableMetrics(false);
+#endif
+                    }
             };
         }
     }
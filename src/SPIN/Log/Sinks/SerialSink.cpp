@@ -32,8 +32,11 @@
 #else
     #include <ostream>
     #include <cstdint>
+    #include <cstring>
 #endif
 
+#include <SPIN/Log/Clock.hpp>
+
 static const char uncolouredTag[6][7] = {
     "[VER]:",
     "[DEB]:",
@@ -50,6 +53,10 @@ static const char colouredTag[6][16] = {
     "[\e[31mERR\e[0m]:",
     "[\e[91mFAT\e[0m]:"
 };
+#ifndef ARDUINO
+// A batch is assembled in a buffer of this size and written to the stream in one call.
+static const std::size_t batchBufferSize = 4096;
+#endif
 
 
 
@@ -62,14 +69,16 @@ SPIN::Log::Sinks::SerialSink::SerialSink(std::ostream* stream, bool coloured)
     this->_stream = stream;
     this->_coloured = coloured;
 }
-SPIN::Log::Sinks::SerialSink::SerialSink(const SPIN::Log::Sinks::SerialSink& obj)
+SPIN::Log::Sinks::SerialSink::SerialSink(const SPIN::Log::Sinks::SerialSink& obj) : SPIN::Log::Sinks::ISink(obj)
 {
     this->_stream = obj._stream;
     this->_coloured = obj._coloured;
+    this->_timestamps = obj._timestamps;
 }
-SPIN::Log::Sinks::SerialSink::SerialSink(SPIN::Log::Sinks::SerialSink&& deadObj) noexcept {
+SPIN::Log::Sinks::SerialSink::SerialSink(SPIN::Log::Sinks::SerialSink&& deadObj) noexcept : SPIN::Log::Sinks::ISink(deadObj) {
     this->_stream = deadObj._stream;
     this->_coloured = deadObj._coloured;
+    this->_timestamps = deadObj._timestamps;
 
     deadObj._stream = nullptr;
 }
@@ -83,6 +92,15 @@ void SPIN::Log::Sinks::SerialSink::Handle(SPIN::Log::LogLevel logLevel, const ch
 
     const char* tag = (this->_coloured) ? colouredTag[(uint8_t)logLevel] : uncolouredTag[(uint8_t)logLevel];
 
+    if (this->_timestamps)
+    {
+#ifdef ARDUINO
+        this->_stream->write((const uint8_t*)(this->_prefix.Render(SPIN::Log::Clock::Microseconds())), SPIN::Log::Format::TimestampPrefix::Length);
+#else
+        this->_stream->write(this->_prefix.Render(SPIN::Log::Clock::Microseconds()), (std::streamsize)(SPIN::Log::Format::TimestampPrefix::Length));
+#endif
+    }
+
 #ifdef ARDUINO
     this->_stream->print(tag);
     this->_stream->print(' ');
@@ -91,6 +109,97 @@ void SPIN::Log::Sinks::SerialSink::Handle(SPIN::Log::LogLevel logLevel, const ch
     *(this->_stream) << tag << ' ' << message << '\n';
 #endif
 }
+void SPIN::Log::Sinks::SerialSink::Handle(const SPIN::Log::LogRecord& record)
+{
+    if (this->_stream == nullptr)
+    {
+        return;
+    }
+
+    const char* tag = (this->_coloured) ? colouredTag[(uint8_t)(record.level)] : uncolouredTag[(uint8_t)(record.level)];
+    std::size_t tagLength = (this->_coloured) ? sizeof(colouredTag[0]) - 1 : sizeof(uncolouredTag[0]) - 1;
+
+    if (this->_timestamps)
+    {
+#ifdef ARDUINO
+        this->_stream->write((const uint8_t*)(this->_prefix.Render(record.timestamp)), SPIN::Log::Format::TimestampPrefix::Length);
+#else
+        this->_stream->write(this->_prefix.Render(record.timestamp), (std::streamsize)(SPIN::Log::Format::TimestampPrefix::Length));
+#endif
+    }
+
+#ifdef ARDUINO
+    this->_stream->write((const uint8_t*)tag, tagLength);
+    this->_stream->write(' ');
+    this->_stream->write((const uint8_t*)(record.message), record.length);
+    this->_stream->write((const uint8_t*)"\r\n", 2);
+#else
+    this->_stream->write(tag, (std::streamsize)tagLength);
+    this->_stream->put(' ');
+    this->_stream->write(record.message, (std::streamsize)(record.length));
+    this->_stream->put('\n');
+#endif
+}
+void SPIN::Log::Sinks::SerialSink::HandleBatch(const SPIN::Log::LogRecord* records, std::size_t count)
+{
+#ifdef ARDUINO
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (this->Accepts(records[i].level))
+        {
+            this->Handle(records[i]);
+        }
+    }
+#else
+    if (this->_stream == nullptr)
+    {
+        return;
+    }
+
+    char buffer[batchBufferSize];
+    std::size_t used = 0;
+    std::size_t tagLength = (this->_coloured) ? sizeof(colouredTag[0]) - 1 : sizeof(uncolouredTag[0]) - 1;
+    std::size_t prefixLength = (this->_timestamps) ? SPIN::Log::Format::TimestampPrefix::Length : 0;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (!this->Accepts(records[i].level))
+        {
+            continue;
+        }
+
+        std::size_t lineLength = prefixLength + tagLength + 1 + records[i].length + 1;
+        if (used + lineLength > sizeof(buffer))
+        {
+            this->_stream->write(buffer, (std::streamsize)used);
+            used = 0;
+        }
+        // Lines longer than the whole buffer go out on their own.
+        if (lineLength > sizeof(buffer))
+        {
+            this->Handle(records[i]);
+            continue;
+        }
+
+        if (this->_timestamps)
+        {
+            memcpy((void*)(buffer + used), (const void*)(this->_prefix.Render(records[i].timestamp)), prefixLength);
+            used += prefixLength;
+        }
+        memcpy((void*)(buffer + used), (const void*)((this->_coloured) ? colouredTag[(uint8_t)(records[i].level)] : uncolouredTag[(uint8_t)(records[i].level)]), tagLength);
+        used += tagLength;
+        buffer[used++] = ' ';
+        memcpy((void*)(buffer + used), (const void*)(records[i].message), records[i].length);
+        used += records[i].length;
+        buffer[used++] = '\n';
+    }
+
+    if (used != 0)
+    {
+        this->_stream->write(buffer, (std::streamsize)used);
+    }
+#endif
+}
 void SPIN::Log::Sinks::SerialSink::Flush()
 {
 #ifdef ARDUINO
@@ -105,6 +214,8 @@ SPIN::Log::Sinks::SerialSink& SPIN::Log::Sinks::SerialSink::operator=(const SPIN
 SPIN::Log::Sinks::SerialSink& SPIN::Log::Sinks::SerialSink::operator=(SPIN::Log::Sinks::SerialSink&& deadObj) noexcept {
     this->_stream = deadObj._stream;
     this->_coloured = deadObj._coloured;
+    this->_timestamps = deadObj._timestamps;
+    SPIN::Log::Sinks::ISink::operator=(deadObj);
 
     deadObj._stream = nullptr;
 
@@ -118,10 +229,14 @@ SPIN::Log::Sinks::Factory::SerialSinkFactory::SerialSinkFactory(const SPIN::Log:
 {
     this->_stream = obj._stream;
     this->_coloured = obj._coloured;
+    this->_timestamps = obj._timestamps;
+    this->_minimumLevel = obj._minimumLevel;
 }
 SPIN::Log::Sinks::Factory::SerialSinkFactory::SerialSinkFactory(SPIN::Log::Sinks::Factory::SerialSinkFactory&& deadObj) noexcept {
     this->_stream = deadObj._stream;
     this->_coloured = deadObj._coloured;
+    this->_timestamps = deadObj._timestamps;
+    this->_minimumLevel = deadObj._minimumLevel;
 
     deadObj._stream = nullptr;
 }
@@ -143,11 +258,25 @@ SPIN::Log::Sinks::Factory::SerialSinkFactory& SPIN::Log::Sinks::Factory::SerialS
 
     return *this;
 }
+SPIN::Log::Sinks::Factory::SerialSinkFactory& SPIN::Log::Sinks::Factory::SerialSinkFactory::SetTimestamps(bool timestamps)
+{
+    this->_timestamps = timestamps;
+
+    return *this;
+}
+SPIN::Log::Sinks::Factory::SerialSinkFactory& SPIN::Log::Sinks::Factory::SerialSinkFactory::SetMinimumLevel(SPIN::Log::LogLevel logLevel)
+{
+    this->_minimumLevel = logLevel;
+
+    return *this;
+}
 
 
 SPIN::Log::Sinks::SerialSink SPIN::Log::Sinks::Factory::SerialSinkFactory::Build()
 {
     auto sink = SPIN::Log::Sinks::SerialSink(this->_stream, this->_coloured);
+    sink.SetMinimumLevel(this->_minimumLevel);
+    sink._timestamps = this->_timestamps;
 
     return sink;
 }
@@ -157,6 +286,8 @@ SPIN::Log::Sinks::Factory::SerialSinkFactory& SPIN::Log::Sinks::Factory::SerialS
 SPIN::Log::Sinks::Factory::SerialSinkFactory& SPIN::Log::Sinks::Factory::SerialSinkFactory::operator=(SPIN::Log::Sinks::Factory::SerialSinkFactory&& deadObj) noexcept {
     this->_stream = deadObj._stream;
     this->_coloured = deadObj._coloured;
+    this->_timestamps = deadObj._timestamps;
+    this->_minimumLevel = deadObj._minimumLevel;
 
     deadObj._stream = nullptr;
 
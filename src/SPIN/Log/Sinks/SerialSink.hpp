@@ -32,6 +32,7 @@
 #endif
 
 #include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/Format/TimestampPrefix.hpp>
 #include <SPIN/Log/Sinks/ISink.hpp>
 
 namespace SPIN
@@ -55,6 +56,8 @@ namespace SPIN
 #endif
                         _stream = nullptr;
                     bool _coloured = false;
+                    bool _timestamps = false;
+                    SPIN::Log::Format::TimestampPrefix _prefix;
 
 #ifdef ARDUINO
                     SerialSink(Stream*, bool);
@@ -70,6 +73,8 @@ namespace SPIN
                     SerialSink(SerialSink&&) noexcept;
 
                     void Handle(SPIN::Log::LogLevel, const char*) override;
+                    void Handle(const SPIN::Log::LogRecord&) override;
+                    void HandleBatch(const SPIN::Log::LogRecord*, std::size_t) override;
                     void Flush() override;
 
                     SerialSink& operator=(const SerialSink&);
@@ -88,6 +93,8 @@ namespace SPIN
 #endif
                             _stream = nullptr;
                         bool _coloured = false;
+                        bool _timestamps = false;
+                        SPIN::Log::LogLevel _minimumLevel = SPIN::Log::LogLevel::Verbose;
 
                     public:
                         SerialSinkFactory();
@@ -101,6 +108,8 @@ namespace SPIN
 #endif
 
                         SerialSinkFactory& SetColoured(bool);
+                        SerialSinkFactory& SetTimestamps(bool);
+                        SerialSinkFactory& SetMinimumLevel(SPIN::Log::LogLevel);
 
                         SPIN::Log::Sinks::SerialSink Build();
 
@@ -0,0 +1,187 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/SpillPool.hpp>
+
+#ifndef ARDUINO
+
+#include <cstdlib>
+#include <exception>
+#include <new>
+
+
+SPIN::Log::SpillPool::SpillPool(std::size_t maximumSize, std::size_t buffersPerClass)
+{
+    if (buffersPerClass == 0)
+    {
+        buffersPerClass = 1;
+    }
+
+    std::size_t size = smallestSize;
+    while (this->_numberOfClasses < maximumClasses)
+    {
+        SizeClass& sizeClass = this->_classes[this->_numberOfClasses];
+        sizeClass.size = size;
+        sizeClass.data = (char*)malloc(size * buffersPerClass);
+        sizeClass.freeBuffers = (SPIN::Log::Concurrent::FreeList*)malloc(sizeof(SPIN::Log::Concurrent::FreeList));
+        if (sizeClass.data == nullptr || sizeClass.freeBuffers == nullptr)
+        {
+            free((void*)(sizeClass.data));
+            free((void*)(sizeClass.freeBuffers));
+            this->Destroy();
+            throw std::exception();
+        }
+        new (sizeClass.freeBuffers) SPIN::Log::Concurrent::FreeList(buffersPerClass);
+        this->_numberOfClasses++;
+
+        if (size >= maximumSize)
+        {
+            break;
+        }
+        size *= 4;
+    }
+}
+SPIN::Log::SpillPool::SpillPool(SPIN::Log::SpillPool&& deadObj) noexcept
+{
+    for (std::size_t i = 0; i < deadObj._numberOfClasses; i++)
+    {
+        this->_classes[i] = deadObj._classes[i];
+    }
+    this->_numberOfClasses = deadObj._numberOfClasses;
+    this->_misses.store(deadObj._misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    deadObj._numberOfClasses = 0;
+}
+
+
+void SPIN::Log::SpillPool::Destroy()
+{
+    for (std::size_t i = 0; i < this->_numberOfClasses; i++)
+    {
+        this->_classes[i].freeBuffers->~FreeList();
+        free((void*)(this->_classes[i].freeBuffers));
+        free((void*)(this->_classes[i].data));
+    }
+    this->_numberOfClasses = 0;
+}
+
+bool SPIN::Log::SpillPool::Acquire(std::size_t size, Buffer& buffer)
+{
+    for (std::size_t i = 0; i < this->_numberOfClasses; i++)
+    {
+        SizeClass& sizeClass = this->_classes[i];
+        uint32_t index;
+        if (sizeClass.size < size || !sizeClass.freeBuffers->TryPop(index))
+        {
+            continue;
+        }
+
+        buffer.data = sizeClass.data + (std::size_t)index * sizeClass.size;
+        buffer.size = sizeClass.size;
+        buffer.sizeClass = (uint32_t)i;
+        buffer.index = index;
+
+        return true;
+    }
+
+    this->_misses.fetch_add(1, std::memory_order_relaxed);
+
+    return false;
+}
+void SPIN::Log::SpillPool::Release(const Buffer& buffer)
+{
+    this->_classes[buffer.sizeClass].freeBuffers->Push(buffer.index);
+}
+std::size_t SPIN::Log::SpillPool::GetMaximumSize() const
+{
+    return this->_numberOfClasses == 0 ? 0 : this->_classes[this->_numberOfClasses - 1].size;
+}
+uint64_t SPIN::Log::SpillPool::GetMissCount() const
+{
+    return this->_misses.load(std::memory_order_relaxed);
+}
+
+
+SPIN::Log::SpillPool& SPIN::Log::SpillPool::operator=(SPIN::Log::SpillPool&& deadObj) noexcept
+{
+    this->Destroy();
+
+    for (std::size_t i = 0; i < deadObj._numberOfClasses; i++)
+    {
+        this->_classes[i] = deadObj._classes[i];
+    }
+    this->_numberOfClasses = deadObj._numberOfClasses;
+    this->_misses.store(deadObj._misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    deadObj._numberOfClasses = 0;
+
+    return *this;
+}
+
+
+SPIN::Log::SpillPool::~SpillPool()
+{
+    this->Destroy();
+}
+
+
+
+SPIN::Log::Factory::SpillPoolFactory::SpillPoolFactory(const SPIN::Log::Factory::SpillPoolFactory& obj) = default;
+SPIN::Log::Factory::SpillPoolFactory::SpillPoolFactory(SPIN::Log::Factory::SpillPoolFactory&& deadObj) noexcept
+{
+    this->_maximumSize = deadObj._maximumSize;
+    this->_buffersPerClass = deadObj._buffersPerClass;
+}
+
+
+SPIN::Log::Factory::SpillPoolFactory& SPIN::Log::Factory::SpillPoolFactory::SetMaximumSize(std::size_t maximumSize)
+{
+    this->_maximumSize = maximumSize;
+
+    return *this;
+}
+SPIN::Log::Factory::SpillPoolFactory& SPIN::Log::Factory::SpillPoolFactory::SetBuffersPerClass(std::size_t buffersPerClass)
+{
+    this->_buffersPerClass = buffersPerClass;
+
+    return *this;
+}
+
+
+SPIN::Log::SpillPool SPIN::Log::Factory::SpillPoolFactory::Build()
+{
+    return SPIN::Log::SpillPool(this->_maximumSize, this->_buffersPerClass);
+}
+
+
+SPIN::Log::Factory::SpillPoolFactory& SPIN::Log::Factory::SpillPoolFactory::operator=(const SPIN::Log::Factory::SpillPoolFactory& obj) = default;
+SPIN::Log::Factory::SpillPoolFactory& SPIN::Log::Factory::SpillPoolFactory::operator=(SPIN::Log::Factory::SpillPoolFactory&& deadObj) noexcept
+{
+    this->_maximumSize = deadObj._maximumSize;
+    this->_buffersPerClass = deadObj._buffersPerClass;
+
+    return *this;
+}
+
+#endif
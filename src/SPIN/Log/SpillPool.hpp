@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__SPILLPOOL__H__) && defined(__cplusplus) && !defined(ARDUINO)
+#define __LOGGER__SPIN__LOG__SPILLPOOL__H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <SPIN/Log/Concurrent/FreeList.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Factory
+        {
+            class SpillPoolFactory;
+        }
+
+        /**
+         * Buffers for lines longer than a logger's own buffer, allocated once in size classes
+         * growing by four from 1 KiB. Acquire and Release are lock-free and never allocate.
+         **/
+        class SpillPool
+        {
+            public:
+                struct Buffer
+                {
+                    char* data;
+                    std::size_t size;
+                    uint32_t sizeClass;
+                    uint32_t index;
+                };
+
+            private:
+                static constexpr std::size_t maximumClasses = 8;
+                static constexpr std::size_t smallestSize = 1024;
+
+                struct SizeClass
+                {
+                    std::size_t size;
+                    char* data;
+                    SPIN::Log::Concurrent::FreeList* freeBuffers;
+                };
+
+                SizeClass _classes[maximumClasses];
+                std::size_t _numberOfClasses = 0;
+                std::atomic<uint64_t> _misses{ 0 };
+
+                SpillPool(std::size_t, std::size_t);
+
+                void Destroy();
+
+                friend class SPIN::Log::Factory::SpillPoolFactory;
+
+            public:
+                SpillPool() = delete;
+                SpillPool(const SpillPool&) = delete;
+                SpillPool(SpillPool&&) noexcept;
+
+                /**
+                 * Takes a buffer of at least the given size from the smallest class that has one
+                 * free. Returns false, and counts a miss, when the size is over the largest class
+                 * or every fitting buffer is in use.
+                 **/
+                bool Acquire(std::size_t, Buffer&);
+                void Release(const Buffer&);
+                std::size_t GetMaximumSize() const;
+                uint64_t GetMissCount() const;
+
+                SpillPool& operator=(const SpillPool&) = delete;
+                SpillPool& operator=(SpillPool&&) noexcept;
+
+                ~SpillPool();
+        };
+
+        namespace Factory
+        {
+            class SpillPoolFactory
+            {
+                private:
+                    std::size_t _maximumSize = 16384;
+                    std::size_t _buffersPerClass = 4;
+
+                public:
+                    SpillPoolFactory() = default;
+                    SpillPoolFactory(const SpillPoolFactory&);
+                    SpillPoolFactory(SpillPoolFactory&&) noexcept;
+
+                    /** Longest line the pool holds, rounded up to the next size class. **/
+                    SpillPoolFactory& SetMaximumSize(std::size_t);
+                    /** Lines of each size class that can be in flight at once. **/
+                    SpillPoolFactory& SetBuffersPerClass(std::size_t);
+
+                    SPIN::Log::SpillPool Build();
+
+                    SpillPoolFactory& operator=(const SpillPoolFactory&);
+                    SpillPoolFactory& operator=(SpillPoolFactory&&) noexcept;
+            };
+        }
+    }
+}
+
+#endif
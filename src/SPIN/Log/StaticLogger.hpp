@@ -0,0 +1,245 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__STATICLOGGER__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__STATICLOGGER__H__
+
+#ifdef ARDUINO
+    #include <stdarg.h>
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstdarg>
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+#include <SPIN/Log/LoggerFrontEnd.hpp>
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Metrics.hpp>
+#include <SPIN/Log/Format/TypedFormat.hpp>
+#include <SPIN/Log/Sinks/ISink.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Sinks
+        {
+            /**
+             * The sinks of a StaticLogger, stored by value one after the other. Every call names
+             * the sink's own type, so there is no virtual dispatch and the calls can be inlined.
+             * Records still go through the sink's delivery, so its metrics, flush policy and
+             * flush lock apply.
+             * A sink type has to declare Handle(const LogRecord&) itself, like the library sinks do.
+             **/
+            template<typename... Sinks>
+            struct SinkChain;
+
+            template<>
+            struct SinkChain<>
+            {
+                void Handle(const SPIN::Log::LogRecord&)
+                {
+                }
+                void Flush()
+                {
+                }
+                uint8_t LowestLevel() const
+                {
+                    return SPIN_LOG_LEVEL_OFF;
+                }
+#ifndef ARDUINO
+                void EnableMetrics(bool)
+                {
+                }
+                bool GetMetrics(std::size_t, SPIN::Log::Metrics::SinkSnapshot&) const
+                {
+                    return false;
+                }
+#endif
+            };
+
+            template<typename Head, typename... Tail>
+            struct SinkChain<Head, Tail...>
+            {
+                Head head;
+                SPIN::Log::Sinks::SinkChain<Tail...> tail;
+
+                template<typename HeadArgument, typename... TailArguments>
+                explicit SinkChain(HeadArgument&& headSink, TailArguments&&... tailSinks)
+                    : head(static_cast<HeadArgument&&>(headSink)), tail(static_cast<TailArguments&&>(tailSinks)...)
+                {
+                }
+                SinkChain(SinkChain&&) = default;
+                SinkChain(const SinkChain&) = delete;
+
+                void Handle(const SPIN::Log::LogRecord& record)
+                {
+                    if (this->head.Accepts(record.level))
+                    {
+                        this->head.template DeliverAs<Head>(record);
+                    }
+                    this->tail.Handle(record);
+                }
+                void Flush()
+                {
+                    this->head.DeliverFlush();
+                    this->tail.Flush();
+                }
+                uint8_t LowestLevel() const
+                {
+                    uint8_t level = (uint8_t)(this->head.GetMinimumLevel());
+                    uint8_t rest = this->tail.LowestLevel();
+
+                    return (level < rest) ? level : rest;
+                }
+#ifndef ARDUINO
+                void EnableMetrics(bool enable)
+                {
+                    this->head.EnableMetrics(enable);
+                    this->tail.EnableMetrics(enable);
+                }
+                bool GetMetrics(std::size_t index, SPIN::Log::Metrics::SinkSnapshot& snapshot) const
+                {
+                    if (index == 0)
+                    {
+                        return this->head.GetMetrics(snapshot);
+                    }
+
+                    return this->tail.GetMetrics(index - 1, snapshot);
+                }
+#endif
+
+                SinkChain& operator=(const SinkChain&) = delete;
+            };
+
+            template<std::size_t index, typename... Sinks>
+            struct SinkAt;
+
+            template<typename Head, typename... Tail>
+            struct SinkAt<0, Head, Tail...>
+            {
+                typedef Head Type;
+
+                static Type& Get(SPIN::Log::Sinks::SinkChain<Head, Tail...>& chain)
+                {
+                    return chain.head;
+                }
+            };
+
+            template<std::size_t index, typename Head, typename... Tail>
+            struct SinkAt<index, Head, Tail...>
+            {
+                typedef typename SPIN::Log::Sinks::SinkAt<index - 1, Tail...>::Type Type;
+
+                static Type& Get(SPIN::Log::Sinks::SinkChain<Head, Tail...>& chain)
+                {
+                    return SPIN::Log::Sinks::SinkAt<index - 1, Tail...>::Get(chain.tail);
+                }
+            };
+        }
+
+        /**
+         * Logger whose sinks are fixed at compile time and held by value, e.g.
+         * StaticLogger<256, FileSink, SerialSink>. It shares the front end of the other loggers,
+         * storm suppression and metrics included, but fans a record out without virtual calls.
+         * It never allocates unless metrics are enabled, so it can live in static storage.
+         * Formatting works like a non concurrent CFormattedLogger.
+         **/
+        template<std::size_t bufferSize, typename... Sinks>
+        class StaticLogger : public SPIN::Log::LoggerFrontEnd<SPIN::Log::StaticLogger<bufferSize, Sinks...>, bufferSize>
+        {
+            static_assert(sizeof...(Sinks) > 0, "StaticLogger needs at least one sink");
+
+            private:
+                char _buffer[bufferSize] = { 0 };
+                SPIN::Log::Sinks::SinkChain<Sinks...> _sinks;
+
+                void LogExpansion(SPIN::Log::LogRecord& record, va_list args)
+                {
+                    record.length = SPIN::Log::Format::FormatArgumentList(this->_buffer, bufferSize, record.format, args);
+                    this->CountRendered(record.length);
+                    record.message = this->_buffer;
+
+                    this->_sinks.Handle(record);
+                }
+                void LogArguments(SPIN::Log::LogRecord& record, const SPIN::Log::Format::Argument* arguments, std::size_t count)
+                {
+                    record.length = SPIN::Log::Format::FormatArguments(this->_buffer, bufferSize, record.format, arguments, count);
+                    this->CountRendered(record.length);
+                    record.message = this->_buffer;
+
+                    this->_sinks.Handle(record);
+                }
+
+                uint8_t GetLowestSinkLevel() const
+                {
+                    return this->_sinks.LowestLevel();
+                }
+#ifndef ARDUINO
+                void EnableSinkMetrics(bool enable)
+                {
+                    this->_sinks.EnableMetrics(enable);
+                }
+                std::size_t GetSinkCount() const
+                {
+                    return sizeof...(Sinks);
+                }
+                bool GetSinkMetrics(std::size_t index, SPIN::Log::Metrics::SinkSnapshot& snapshot) const
+                {
+                    return this->_sinks.GetMetrics(index, snapshot);
+                }
+#endif
+
+                friend class SPIN::Log::LoggerFrontEnd<SPIN::Log::StaticLogger<bufferSize, Sinks...>, bufferSize>;
+
+            public:
+                template<typename... SinkArguments>
+                explicit StaticLogger(SinkArguments&&... sinks) : _sinks(static_cast<SinkArguments&&>(sinks)...)
+                {
+                    this->RefreshLevels();
+                }
+                StaticLogger(const StaticLogger&) = delete;
+                StaticLogger(StaticLogger&&) = default;
+
+                template<std::size_t index>
+                typename SPIN::Log::Sinks::SinkAt<index, Sinks...>::Type& GetSink()
+                {
+                    return SPIN::Log::Sinks::SinkAt<index, Sinks...>::Get(this->_sinks);
+                }
+
+                void Flush()
+                {
+                    this->ReportSuppressed();
+                    this->_sinks.Flush();
+                }
+
+                StaticLogger& operator=(const StaticLogger&) = delete;
+        };
+    }
+}
+
+#endif
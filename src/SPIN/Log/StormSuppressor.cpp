@@ -0,0 +1,264 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/StormSuppressor.hpp>
+
+#ifdef ARDUINO
+    #include <stdlib.h>
+    #include <string.h>
+#else
+    #include <cstdlib>
+    #include <cstring>
+    #include <exception>
+    #include <new>
+#endif
+
+
+namespace
+{
+    std::size_t HashSite(const char* fmt, const SPIN::Log::SourceLocation& location)
+    {
+        uint64_t hash = (uint64_t)(uintptr_t)fmt * 0x9E3779B97F4A7C15ull;
+        hash ^= ((uint64_t)(uintptr_t)(location.file) + location.line) * 0xC2B2AE3D27D4EB4Full;
+
+        return (std::size_t)(hash ^ (hash >> 29));
+    }
+}
+
+
+
+SPIN::Log::StormSuppressor::StormSuppressor(std::size_t capacity, uint32_t rate, uint32_t burst)
+{
+    std::size_t rounded = 1;
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    this->_entries = (Entry*)malloc(rounded * sizeof(Entry));
+    if (this->_entries == nullptr)
+    {
+#ifndef ARDUINO
+        throw std::exception();
+#endif
+        return;
+    }
+    memset((void*)(this->_entries), 0, rounded * sizeof(Entry));
+#ifndef ARDUINO
+    for (std::size_t i = 0; i < rounded; i++)
+    {
+        new (&(this->_entries[i].lock)) SPIN::Log::Concurrent::SpinLock();
+    }
+#endif
+
+    this->_capacity = rounded;
+    this->_rate = rate;
+    this->_burst = (uint64_t)(burst > 0 ? burst : 1) * tokenScale;
+}
+SPIN::Log::StormSuppressor::StormSuppressor(SPIN::Log::StormSuppressor&& deadObj) noexcept
+{
+    this->_entries = deadObj._entries;
+    this->_capacity = deadObj._capacity;
+    this->_rate = deadObj._rate;
+    this->_burst = deadObj._burst;
+
+    deadObj._entries = nullptr;
+    deadObj._capacity = 0;
+}
+
+
+void SPIN::Log::StormSuppressor::LockEntry(Entry& entry)
+{
+#ifndef ARDUINO
+    entry.lock.Lock();
+#else
+    (void)entry;
+#endif
+}
+void SPIN::Log::StormSuppressor::UnlockEntry(Entry& entry)
+{
+#ifndef ARDUINO
+    entry.lock.Unlock();
+#else
+    (void)entry;
+#endif
+}
+
+bool SPIN::Log::StormSuppressor::Admit(const char* fmt, const SPIN::Log::SourceLocation& location, SPIN::Log::LogLevel logLevel, uint64_t now, uint64_t& repeats)
+{
+    repeats = 0;
+    if (this->_entries == nullptr || logLevel == SPIN::Log::LogLevel::Fatal)
+    {
+        return true;
+    }
+
+    std::size_t hash = HashSite(fmt, location);
+    for (std::size_t probe = 0; probe < maximumProbes; probe++)
+    {
+        Entry& entry = this->_entries[(hash + probe) & (this->_capacity - 1)];
+        this->LockEntry(entry);
+
+        if (entry.format == nullptr)
+        {
+            entry.format = fmt;
+            entry.file = location.file;
+            entry.line = location.line;
+            entry.level = logLevel;
+            entry.tokens = this->_burst;
+            entry.lastRefill = now;
+        }
+        else if (entry.format != fmt || entry.file != location.file || entry.line != location.line)
+        {
+            this->UnlockEntry(entry);
+            continue;
+        }
+
+        if (now > entry.lastRefill && this->_rate > 0)
+        {
+            uint64_t elapsed = now - entry.lastRefill;
+            uint64_t missing = this->_burst - entry.tokens;
+            entry.tokens = (elapsed >= missing / this->_rate) ? this->_burst : entry.tokens + elapsed * this->_rate;
+            entry.lastRefill = now;
+        }
+
+        bool admitted = entry.tokens >= tokenScale;
+        if (admitted)
+        {
+            entry.tokens -= tokenScale;
+            repeats = entry.suppressed;
+            entry.suppressed = 0;
+        }
+        else
+        {
+            entry.suppressed++;
+        }
+
+        this->UnlockEntry(entry);
+        return admitted;
+    }
+
+    return true;
+}
+std::size_t SPIN::Log::StormSuppressor::Collect(Summary* summaries, std::size_t count)
+{
+    std::size_t collected = 0;
+    for (std::size_t i = 0; i < this->_capacity && collected < count; i++)
+    {
+        Entry& entry = this->_entries[i];
+        this->LockEntry(entry);
+
+        if (entry.suppressed > 0)
+        {
+            Summary& summary = summaries[collected++];
+            summary.format = entry.format;
+            summary.location.file = entry.file;
+            summary.location.line = entry.line;
+            summary.location.function = nullptr;
+            summary.level = entry.level;
+            summary.repeats = entry.suppressed;
+            entry.suppressed = 0;
+        }
+
+        this->UnlockEntry(entry);
+    }
+
+    return collected;
+}
+
+
+SPIN::Log::StormSuppressor& SPIN::Log::StormSuppressor::operator=(SPIN::Log::StormSuppressor&& deadObj) noexcept
+{
+    if (this->_entries != nullptr)
+    {
+        free((void*)(this->_entries));
+    }
+
+    this->_entries = deadObj._entries;
+    this->_capacity = deadObj._capacity;
+    this->_rate = deadObj._rate;
+    this->_burst = deadObj._burst;
+
+    deadObj._entries = nullptr;
+    deadObj._capacity = 0;
+
+    return *this;
+}
+
+
+SPIN::Log::StormSuppressor::~StormSuppressor()
+{
+    if (this->_entries != nullptr)
+    {
+        free((void*)(this->_entries));
+    }
+    this->_entries = nullptr;
+    this->_capacity = 0;
+}
+
+
+
+SPIN::Log::Factory::StormSuppressorFactory::StormSuppressorFactory(const SPIN::Log::Factory::StormSuppressorFactory& obj) = default;
+SPIN::Log::Factory::StormSuppressorFactory::StormSuppressorFactory(SPIN::Log::Factory::StormSuppressorFactory&& deadObj) noexcept
+{
+    this->_capacity = deadObj._capacity;
+    this->_rate = deadObj._rate;
+    this->_burst = deadObj._burst;
+}
+
+
+SPIN::Log::Factory::StormSuppressorFactory& SPIN::Log::Factory::StormSuppressorFactory::SetCapacity(std::size_t capacity)
+{
+    this->_capacity = capacity;
+
+    return *this;
+}
+SPIN::Log::Factory::StormSuppressorFactory& SPIN::Log::Factory::StormSuppressorFactory::SetRate(uint32_t rate)
+{
+    this->_rate = rate;
+
+    return *this;
+}
+SPIN::Log::Factory::StormSuppressorFactory& SPIN::Log::Factory::StormSuppressorFactory::SetBurst(uint32_t burst)
+{
+    this->_burst = burst;
+
+    return *this;
+}
+
+
+SPIN::Log::StormSuppressor SPIN::Log::Factory::StormSuppressorFactory::Build()
+{
+    return SPIN::Log::StormSuppressor(this->_capacity, this->_rate, this->_burst);
+}
+
+
+SPIN::Log::Factory::StormSuppressorFactory& SPIN::Log::Factory::StormSuppressorFactory::operator=(const SPIN::Log::Factory::StormSuppressorFactory& obj) = default;
+SPIN::Log::Factory::StormSuppressorFactory& SPIN::Log::Factory::StormSuppressorFactory::operator=(SPIN::Log::Factory::StormSuppressorFactory&& deadObj) noexcept
+{
+    this->_capacity = deadObj._capacity;
+    this->_rate = deadObj._rate;
+    this->_burst = deadObj._burst;
+
+    return *this;
+}
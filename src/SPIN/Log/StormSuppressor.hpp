@@ -0,0 +1,147 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#if !defined(__LOGGER__SPIN__LOG__STORMSUPPRESSOR__H__) && defined(__cplusplus)
+#define __LOGGER__SPIN__LOG__STORMSUPPRESSOR__H__
+
+#ifdef ARDUINO
+    #include <stddef.h>
+    #include <stdint.h>
+#else
+    #include <cstddef>
+    #include <cstdint>
+#endif
+
+#include <SPIN/Log/LogLevel.hpp>
+#include <SPIN/Log/LogRecord.hpp>
+#include <SPIN/Log/Concurrent/SpinLock.hpp>
+
+namespace SPIN
+{
+    namespace Log
+    {
+        namespace Factory
+        {
+            class StormSuppressorFactory;
+        }
+
+        /**
+         * Rate limits each call site (format pointer plus source location) with a token bucket
+         * kept in a small open addressed table, allocated once. Records over the limit are only
+         * counted, the count comes back with the next record let through from that call site.
+         * Fatal records always pass, as does everything once the table has no room left.
+         **/
+        class StormSuppressor
+        {
+            public:
+                struct Summary
+                {
+                    const char* format;
+                    SPIN::Log::SourceLocation location;
+                    SPIN::Log::LogLevel level;
+                    uint64_t repeats;
+                };
+
+            private:
+                static constexpr std::size_t maximumProbes = 4;
+                static constexpr uint64_t tokenScale = 1000000;
+
+                struct Entry
+                {
+                    const char* format;
+                    const char* file;
+                    uint32_t line;
+                    SPIN::Log::LogLevel level;
+                    uint64_t tokens;
+                    uint64_t lastRefill;
+                    uint64_t suppressed;
+#ifndef ARDUINO
+                    SPIN::Log::Concurrent::SpinLock lock;
+#endif
+                };
+
+                Entry* _entries = nullptr;
+                std::size_t _capacity = 0;
+                uint64_t _rate = 0;
+                uint64_t _burst = 0;
+
+                StormSuppressor(std::size_t, uint32_t, uint32_t);
+
+                void LockEntry(Entry&);
+                void UnlockEntry(Entry&);
+
+                friend class SPIN::Log::Factory::StormSuppressorFactory;
+
+            public:
+                StormSuppressor() = delete;
+                StormSuppressor(const StormSuppressor&) = delete;
+                StormSuppressor(StormSuppressor&&) noexcept;
+
+                /**
+                 * Takes one token for the call site. Returns false when the record should be
+                 * dropped, otherwise repeats holds how many records were dropped since the last one.
+                 **/
+                bool Admit(const char*, const SPIN::Log::SourceLocation&, SPIN::Log::LogLevel, uint64_t, uint64_t& repeats);
+                /**
+                 * Moves up to the given number of pending repeat counts out of the table, for call
+                 * sites that went quiet while suppressed. Returns how many were written.
+                 **/
+                std::size_t Collect(Summary*, std::size_t);
+
+                StormSuppressor& operator=(const StormSuppressor&) = delete;
+                StormSuppressor& operator=(StormSuppressor&&) noexcept;
+
+                ~StormSuppressor();
+        };
+
+        namespace Factory
+        {
+            class StormSuppressorFactory
+            {
+                private:
+                    std::size_t _capacity = 64;
+                    uint32_t _rate = 10;
+                    uint32_t _burst = 20;
+
+                public:
+                    StormSuppressorFactory() = default;
+                    StormSuppressorFactory(const StormSuppressorFactory&);
+                    StormSuppressorFactory(StormSuppressorFactory&&) noexcept;
+
+                    /** Number of call sites tracked, rounded up to a power of two. **/
+                    StormSuppressorFactory& SetCapacity(std::size_t);
+                    /** Records per second let through per call site once the burst is used up. **/
+                    StormSuppressorFactory& SetRate(uint32_t);
+                    StormSuppressorFactory& SetBurst(uint32_t);
+
+                    SPIN::Log::StormSuppressor Build();
+
+                    StormSuppressorFactory& operator=(const StormSuppressorFactory&);
+                    StormSuppressorFactory& operator=(StormSuppressorFactory&&) noexcept;
+            };
+        }
+    }
+}
+
+#endif
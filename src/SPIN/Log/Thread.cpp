@@ -0,0 +1,68 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2022 SPIN - Space Innovation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ **/
+
+#include <SPIN/Log/Thread.hpp>
+
+#ifndef ARDUINO
+    #include <atomic>
+#endif
+
+
+#ifndef ARDUINO
+static std::atomic<uint32_t> nextThreadId{ 1 };
+static thread_local bool realTime = false;
+#endif
+
+
+uint32_t SPIN::Log::Thread::CurrentId()
+{
+#ifdef ARDUINO
+    return 0;
+#else
+    static thread_local uint32_t threadId = 0;
+
+    if (threadId == 0)
+    {
+        threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return threadId;
+#endif
+}
+void SPIN::Log::Thread::SetRealTime(bool isRealTime)
+{
+#ifndef ARDUINO
+    realTime = isRealTime;
+#else
+    (void)isRealTime;
+#endif
+}
+bool SPIN::Log::Thread::IsRealTime()
+{
+#ifdef ARDUINO
+    return false;
+#else
+    return realTime;
+#endif
+}